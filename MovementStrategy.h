@@ -16,7 +16,9 @@
 #define MOVEMENTSTRATEGY_H
 #pragma once
 
+#include <vector>
 #include "TelemetryTypes.h"
+#include "FleetState.h"
 
 // Abstract base class defining the interface for all movement algorithms (Strategy Pattern).
 class MovementStrategy
@@ -27,6 +29,18 @@ public:
     // dt in seconds
     // Pure virtual function: Calculates and returns the next telemetry state based on the movement logic.
     virtual TelemetrySnapshot step(const TelemetrySnapshot &current, double dt) = 0;
+
+    // Advances every drone listed in members (indices into fleet) by dt seconds.
+    // Default: gathers a snapshot per drone and calls step(). Strategies that keep
+    // per-drone state or can work on whole columns override this.
+    virtual void stepBatch(FleetState &fleet, const std::vector<int> &members, double dt)
+    {
+        for (int i : members)
+            fleet.store(i, step(fleet.snapshot(i), dt));
+    }
+
+    // True if the strategy computes battery drain itself (the simulator then skips its fixed drain).
+    virtual bool modelsBattery() const { return false; }
 };
 
 #endif // MOVEMENTSTRATEGY_H
\ No newline at end of file
@@ -0,0 +1,22 @@
+/******************************************************************************
+ * fleetfixture.h
+ * Author: Jatin Kumawat
+ * Date: 19-10-2026
+ *
+ * Description:
+ *   Fleet fixture shared by the tests of the batch passes over FleetState.
+ ******************************************************************************/
+
+#pragma once
+
+#include "../FleetState.h"
+
+// count drones "D-0", "D-1", ... in group 0 with strategy 0, at the origin of region 0.
+inline FleetState makeFleet(int count)
+{
+    FleetState fleet;
+    for (int i = 0; i < count; ++i) {
+        fleet.add(QString("D-%1").arg(i), 0, 0);
+    }
+    return fleet;
+}
@@ -0,0 +1,500 @@
+/******************************************************************************
+ * soak_fleet.cpp
+ * Author: Jatin Kumawat
+ * Date: 19-10-2026
+ *
+ * Description:
+ *   Scale soak test: a whole fleet simulated headless and accelerated.
+ *
+ *   - Builds a fleet with the factory and ticks it back to back with
+ *  DroneSimulator::advance() (simulated time, no timer), mixing
+ *  strategies and overrides through the command queue as operators would
+ *   - Streams to a loopback UDP socket and records to a temporary columnar
+ *  file by default, so the UDP ring and the recorder buffers carry the
+ *  whole fleet every tick
+ *   - Records ticks/s, p99 tick time, peak RSS (gated on the part the fleet
+ *  adds to the process) and queue drops (commands, UDP ring, recorder)
+ *   - Compares them with the checked-in baseline row for the fleet size and
+ *  fails (exit 1) when a result regresses beyond the tolerance, or when
+ *  the baseline file or its row for the fleet size is missing
+ *
+ *   Usage: SoakFleet <drones> <simulated minutes> [options]
+ *     --baseline <file>        baseline table (Tests/soak_baseline.txt)
+ *     --tolerance <f>          allowed throughput/latency regression (0.35)
+ *     --memory-tolerance <f>   allowed fleet RSS growth (0.15)
+ *     --memory-floor <MB>      fleet RSS growth always allowed (2), above page-level noise
+ *     --update-baseline        write this run's results as the baseline row
+ *     --udp <host:port>        stream there instead of the loopback sink
+ *     --record <path>          record there instead of a temporary file
+ ******************************************************************************/
+
+#include <QCoreApplication>
+#include <QTemporaryDir>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include "../DroneSimulator.h"
+#include "../SimulatorFactory.h"
+
+namespace
+{
+
+    // One row of the baseline table.
+    struct SoakResult
+    {
+        double ticksPerSecond = 0.0;
+        double p99Ms = 0.0;
+        double fleetRssMb = 0.0; // Peak RSS above the process before the fleet was built.
+        unsigned long long drops = 0;
+    };
+
+    // Process peak and current resident set (MB); 0 where not measured (the memory gate is then skipped).
+    double peakRssMb()
+    {
+
+#ifdef __linux__
+        rusage usage{};
+
+        getrusage(RUSAGE_SELF, &usage);
+
+        return double(usage.ru_maxrss) / 1024.0; // kilobytes on Linux
+#else
+        return 0.0;
+#endif
+    }
+
+    double currentRssMb()
+    {
+
+#ifdef __linux__
+        long pages = 0, resident = 0;
+
+        std::ifstream statm("/proc/self/statm");
+
+        if (statm >> pages >> resident)
+            return double(resident) * double(sysconf(_SC_PAGESIZE)) / (1024.0 * 1024.0);
+#endif
+        return 0.0;
+    }
+
+    // UDP socket on an ephemeral loopback port that takes the soak's stream (never read: the
+    // kernel discards what does not fit, the publisher sees a real socket either way).
+    class LoopbackSink
+    {
+    public:
+        LoopbackSink()
+        {
+
+#ifdef __linux__
+            m_fd = socket(AF_INET, SOCK_DGRAM, 0);
+
+            sockaddr_in addr{};
+
+            addr.sin_family = AF_INET;
+
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+            socklen_t length = sizeof(addr);
+
+            if (m_fd >= 0 && bind(m_fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) == 0
+                && getsockname(m_fd, reinterpret_cast<sockaddr *>(&addr), &length) == 0)
+                m_port = ntohs(addr.sin_port);
+#endif
+        }
+
+        ~LoopbackSink()
+        {
+
+#ifdef __linux__
+            if (m_fd >= 0)
+                ::close(m_fd);
+#endif
+        }
+
+        LoopbackSink(const LoopbackSink &) = delete;
+        LoopbackSink &operator=(const LoopbackSink &) = delete;
+
+        quint16 port() const { return m_port; } // 0 if the socket could not be bound.
+
+    private:
+        int m_fd = -1;
+        quint16 m_port = 0;
+    };
+
+    // Rows keyed by fleet size; comment lines (#) are kept in header.
+    bool readBaseline(const std::string &path, std::string &header, std::map<int, SoakResult> &rows)
+    {
+
+        std::ifstream in(path);
+
+        if (!in)
+            return false;
+
+        std::string line;
+
+        while (std::getline(in, line))
+        {
+
+            if (line.empty() || line[0] == '#')
+            {
+
+                header += line + "\n";
+
+                continue;
+            }
+
+            std::istringstream fields(line);
+
+            int drones = 0;
+
+            SoakResult r;
+
+            if (fields >> drones >> r.ticksPerSecond >> r.p99Ms >> r.fleetRssMb >> r.drops)
+                rows[drones] = r;
+        }
+
+        return true;
+    }
+
+    bool writeBaseline(const std::string &path, const std::string &header, const std::map<int, SoakResult> &rows)
+    {
+
+        std::ofstream out(path, std::ios::trunc);
+
+        out << header;
+
+        for (const auto &row : rows)
+        {
+
+            char line[160];
+
+            std::snprintf(line, sizeof(line), "%-8d %-12.1f %-8.3f %-12.1f %llu\n", row.first, row.second.ticksPerSecond,
+                          row.second.p99Ms, row.second.fleetRssMb, row.second.drops);
+
+            out << line;
+        }
+
+        return bool(out);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+
+    if (argc < 3)
+    {
+
+        std::fprintf(stderr, "usage: %s <drones> <simulated minutes> [--baseline file] [--tolerance f] "
+                             "[--memory-tolerance f] [--memory-floor MB] [--update-baseline] [--udp host:port] [--record path]\n",
+                     argv[0]);
+
+        return 2;
+    }
+
+    QCoreApplication app(argc, argv);
+
+    const int drones = std::max(1, std::atoi(argv[1]));
+
+    const double minutes = std::atof(argv[2]);
+
+    std::string baselinePath, udpTarget, recordPath;
+
+    double tolerance = 0.35, memoryTolerance = 0.15, memoryFloorMb = 2.0;
+
+    bool update = false;
+
+    for (int a = 3; a < argc; ++a)
+    {
+
+        const std::string arg = argv[a];
+
+        const bool hasValue = a + 1 < argc;
+
+        if (arg == "--baseline" && hasValue)
+            baselinePath = argv[++a];
+        else if (arg == "--tolerance" && hasValue)
+            tolerance = std::atof(argv[++a]);
+        else if (arg == "--memory-tolerance" && hasValue)
+            memoryTolerance = std::atof(argv[++a]);
+        else if (arg == "--memory-floor" && hasValue)
+            memoryFloorMb = std::atof(argv[++a]);
+        else if (arg == "--update-baseline")
+            update = true;
+        else if (arg == "--udp" && hasValue)
+            udpTarget = argv[++a];
+        else if (arg == "--record" && hasValue)
+            recordPath = argv[++a];
+        else
+        {
+
+            std::fprintf(stderr, "unknown option %s\n", arg.c_str());
+
+            return 2;
+        }
+    }
+
+    // read first: a gate that cannot find its baseline fails before the run, and a wrong path must not pass silently
+
+    std::string header;
+
+    std::map<int, SoakResult> rows;
+
+    const bool haveFile = !baselinePath.empty() && readBaseline(baselinePath, header, rows);
+
+    if (!baselinePath.empty() && !update)
+    {
+
+        if (!haveFile)
+        {
+
+            std::printf("FAIL cannot read baseline %s\n", baselinePath.c_str());
+
+            return 1;
+        }
+
+        if (!rows.count(drones))
+        {
+
+            std::printf("FAIL no baseline row for %d drones in %s (create it on the CI runner with --update-baseline)\n", drones,
+                        baselinePath.c_str());
+
+            return 1;
+        }
+    }
+
+    // outputs on by default: without them the UDP and recorder drop counters could never move
+
+    LoopbackSink sink;
+
+    QTemporaryDir recordDir;
+
+    if (udpTarget.empty())
+    {
+
+        if (!sink.port())
+        {
+
+            std::fprintf(stderr, "udp: cannot bind a loopback socket\n");
+
+            return 2;
+        }
+
+        udpTarget = "127.0.0.1:" + std::to_string(sink.port());
+    }
+
+    if (recordPath.empty())
+    {
+
+        if (!recordDir.isValid())
+        {
+
+            std::fprintf(stderr, "record: cannot create a temporary directory\n");
+
+            return 2;
+        }
+
+        recordPath = recordDir.filePath("soak.col").toStdString();
+    }
+
+    // memory is gated on what the fleet adds, not on the size of the Qt libraries loaded
+
+    const double startRssMb = currentRssMb();
+
+    // --- fleet: groups of 25, every built-in strategy flying its share of the groups ---
+
+    const int groupSize = 25;
+
+    const int groups = (drones + groupSize - 1) / groupSize;
+
+    std::unique_ptr<DroneSimulator> sim(new DroneSimulator("soak"));
+
+    SimulatorFactory::registerBuiltinStrategies(sim.get());
+
+    for (int i = 0; i < drones; ++i)
+        sim->addDrone(QString("S-%1").arg(i + 1), i / groupSize, (i / groupSize) % StrategyType::Count);
+
+    QString error;
+
+    const QString target = QString::fromStdString(udpTarget);
+
+    const int colon = target.lastIndexOf(':');
+
+    if (colon < 0 || !sim->openUdpPublisher(target.left(colon), quint16(target.mid(colon + 1).toUInt()), &error))
+    {
+
+        std::fprintf(stderr, "udp: %s\n", qPrintable(error));
+
+        return 2;
+    }
+
+    if (!sim->openRecording(QString::fromStdString(recordPath), &error))
+    {
+
+        std::fprintf(stderr, "record: %s\n", qPrintable(error));
+
+        return 2;
+    }
+
+    // the app ticks every 500 ms; here ticks run back to back
+
+    const double dt = 0.5;
+
+    const int ticks = std::max(1, int(minutes * 60.0 / dt));
+
+    qint64 nowMs = 1700000000000LL;
+
+    std::vector<double> tickMs;
+
+    tickMs.reserve(ticks);
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for (int t = 0; t < ticks; ++t)
+    {
+
+        // operator traffic: a group switches strategy every 10 ticks, overrides come and go
+
+        if (t % 10 == 0)
+        {
+
+            const int g = (t / 10) % groups;
+
+            sim->submitCommand(FleetCommand::setStrategy((t / 10) % StrategyType::Count, FleetCommand::Scope::Group, g));
+
+            sim->submitCommand(FleetCommand::overrideSpeed(4.0, FleetCommand::Scope::Group, (g + 1) % groups));
+
+            sim->submitCommand(FleetCommand::clearOverrides(FleetCommand::Scope::Group, (g + groups - 1) % groups));
+        }
+
+        const auto tickStart = std::chrono::steady_clock::now();
+
+        sim->advance(dt, nowMs);
+
+        tickMs.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - tickStart).count());
+
+        nowMs += qint64(dt * 1000.0);
+    }
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    SoakResult result;
+
+    result.ticksPerSecond = double(ticks) / seconds;
+
+    const std::size_t p99 = std::min(tickMs.size() - 1, std::size_t(double(tickMs.size()) * 0.99));
+
+    std::nth_element(tickMs.begin(), tickMs.begin() + p99, tickMs.end());
+
+    result.p99Ms = tickMs[p99];
+
+    const double peakMb = peakRssMb();
+
+    result.fleetRssMb = peakMb > 0.0 ? std::max(0.0, peakMb - startRssMb) : 0.0;
+
+    // drops happen on the tick thread (queue or ring full), so the counts are final here
+
+    const unsigned long long commandDrops = sim->commandsDropped();
+
+    const unsigned long long udpDrops = sim->udpPublisher().recordsDropped();
+
+    const unsigned long long recorderDrops = sim->recorder().rowsDropped();
+
+    result.drops = commandDrops + udpDrops + recorderDrops;
+
+    std::printf("soak: %d drones, %d ticks (%.1f simulated min) in %.1f s: %.1f ticks/s, p99 %.3f ms, "
+                "peak RSS %.1f MB (fleet %.1f MB), %llu drops (commands %llu, UDP %llu, recorder %llu)\n",
+                drones, ticks, minutes, seconds, result.ticksPerSecond, result.p99Ms, peakMb, result.fleetRssMb, result.drops,
+                commandDrops, udpDrops, recorderDrops);
+
+    sim.reset();
+
+    if (baselinePath.empty())
+        return 0;
+
+    if (update)
+    {
+
+        if (!haveFile)
+            header = "# drones  ticks/s      p99_ms   fleet_rss_mb drops\n";
+
+        rows[drones] = result;
+
+        if (!writeBaseline(baselinePath, header, rows))
+        {
+
+            std::fprintf(stderr, "cannot write %s\n", baselinePath.c_str());
+
+            return 2;
+        }
+
+        std::printf("baseline for %d drones updated\n", drones);
+
+        return 0;
+    }
+
+    // --- gates: each failure is printed, any failure fails the run ---
+
+    const SoakResult &base = rows.at(drones);
+
+    bool ok = true;
+
+    if (result.ticksPerSecond < base.ticksPerSecond * (1.0 - tolerance))
+    {
+
+        std::printf("FAIL throughput %.1f ticks/s < %.1f (baseline %.1f, tolerance %.0f%%)\n", result.ticksPerSecond,
+                    base.ticksPerSecond * (1.0 - tolerance), base.ticksPerSecond, tolerance * 100.0);
+
+        ok = false;
+    }
+
+    if (result.p99Ms > base.p99Ms * (1.0 + tolerance))
+    {
+
+        std::printf("FAIL p99 tick %.3f ms > %.3f (baseline %.3f, tolerance %.0f%%)\n", result.p99Ms,
+                    base.p99Ms * (1.0 + tolerance), base.p99Ms, tolerance * 100.0);
+
+        ok = false;
+    }
+
+    // a small fleet's RSS is a few pages: a percentage alone would sit inside page-level noise
+
+    const double memorySlackMb = std::max(base.fleetRssMb * memoryTolerance, memoryFloorMb);
+
+    if (result.fleetRssMb > 0.0 && base.fleetRssMb > 0.0 && result.fleetRssMb > base.fleetRssMb + memorySlackMb)
+    {
+
+        std::printf("FAIL fleet RSS %.1f MB > %.1f (baseline %.1f, tolerance max(%.0f%%, %.1f MB))\n", result.fleetRssMb,
+                    base.fleetRssMb + memorySlackMb, base.fleetRssMb, memoryTolerance * 100.0, memoryFloorMb);
+
+        ok = false;
+    }
+
+    if (result.drops > base.drops)
+    {
+
+        std::printf("FAIL %llu drops > %llu (baseline)\n", result.drops, base.drops);
+
+        ok = false;
+    }
+
+    std::printf("%s against the baseline for %d drones\n", ok ? "PASS" : "FAIL", drones);
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,203 @@
+#include <QtTest>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "../ColumnarRecorder.h"
+#include "../ColumnarReader.h"
+
+class TestColumnar : public QObject {
+    Q_OBJECT
+
+private:
+    // unique per process so parallel test runs do not collide
+    static std::string tempPath(const char *suffix) {
+        return (std::filesystem::temp_directory_path() / ("columnar-test-" + std::to_string(QCoreApplication::applicationPid()) + "-" + suffix + ".dtcol")).string();
+    }
+
+    static TelemetrySnapshot sample(int drone, int tick) {
+        TelemetrySnapshot snap;
+        snap.latitude = 28.6 + drone * 1e-4 + tick * 1e-6;
+        snap.longitude = 77.2 - drone * 1e-4;
+        snap.altitude = 10.0 * tick + drone * 0.001;
+        snap.heading = (drone % 360) + 0.25;
+        snap.speed = 8.5;
+        snap.battery = 100 - tick;
+        snap.gpsFix = TelemetrySnapshot::GpsFix::Fix3D;
+        snap.timestampMs = 1000 * tick;
+        return snap;
+    }
+
+    // drones x ticks samples, tick-major like the simulator
+    static void recordRun(ColumnarRecorder &recorder, int drones, int ticks) {
+        for (int i = 0; i < drones; ++i) {
+            recorder.setId(i, QString("D-%1").arg(i));
+        }
+        for (int t = 0; t < ticks; ++t) {
+            for (int i = 0; i < drones; ++i) {
+                recorder.record(i, sample(i, t));
+            }
+        }
+    }
+
+private slots:
+
+    void test_codec_round_trip() {
+        const std::vector<std::int64_t> in = {0, 1, -1, 1000, 999, std::numeric_limits<std::int64_t>::max(),
+                                              std::numeric_limits<std::int64_t>::min(), 42, 42, 42};
+        std::vector<unsigned char> bytes;
+        std::int64_t min = 0, max = 0;
+        ColumnarFormat::encodeChunk(in.data(), in.size(), bytes, min, max);
+        QCOMPARE(min, std::numeric_limits<std::int64_t>::min());
+        QCOMPARE(max, std::numeric_limits<std::int64_t>::max());
+
+        std::vector<std::int64_t> out(in.size());
+        QVERIFY(ColumnarFormat::decodeChunk(bytes.data(), bytes.size(), out.size(), out.data()));
+        QVERIFY(out == in);
+        QVERIFY2(!ColumnarFormat::decodeChunk(bytes.data(), bytes.size() - 1, out.size(), out.data()), "A truncated chunk is rejected");
+    }
+
+    void test_recording_round_trip() {
+        const std::string path = tempPath("rt");
+        const int drones = 1000, ticks = 6;
+        {
+            ColumnarRecorder recorder;
+            QString error;
+            QVERIFY2(recorder.open(QString::fromUtf8(path.c_str()), 1024, 8, &error), qPrintable(error));
+            recordRun(recorder, drones, ticks);
+            recorder.close();
+            QCOMPARE(recorder.rowsRecorded(), std::uint64_t(drones * ticks));
+            QCOMPARE(recorder.rowsDropped(), std::uint64_t(0));
+        }
+
+        ColumnarReader reader;
+        std::string error;
+        QVERIFY2(reader.open(path, &error), error.c_str());
+        QCOMPARE(reader.rowCount(), std::uint64_t(drones * ticks));
+        QCOMPARE(reader.rowGroupCount(), (drones * ticks + 1023) / 1024);
+        QCOMPARE(int(reader.ids().size()), drones);
+        QVERIFY(reader.ids()[7] == "D-7");
+
+        const int drone = reader.findColumn("drone");
+        const int tick = reader.findColumn("timestamp_ms");
+        const int lat = reader.findColumn("latitude");
+        const int alt = reader.findColumn("altitude");
+        const int heading = reader.findColumn("heading");
+        QVERIFY(drone >= 0 && tick >= 0 && lat >= 0 && alt >= 0 && heading >= 0);
+        QCOMPARE(reader.findColumn("no-such-column"), -1);
+
+        // every sample comes back once, within the quantization step; statistics bound the chunk
+        std::vector<int> seen(drones * ticks, 0);
+        std::vector<std::int64_t> ids, times;
+        std::vector<double> lats, alts, headings;
+        bool exact = true, bounded = true;
+        for (int g = 0; g < reader.rowGroupCount(); ++g) {
+            QVERIFY(reader.readColumn(g, drone, ids));
+            QVERIFY(reader.readColumn(g, tick, times));
+            QVERIFY(reader.readColumn(g, lat, lats));
+            QVERIFY(reader.readColumn(g, alt, alts));
+            QVERIFY(reader.readColumn(g, heading, headings));
+            for (std::size_t r = 0; r < ids.size(); ++r) {
+                const int i = int(ids[r]), t = int(times[r] / 1000);
+                ++seen[t * drones + i];
+                const TelemetrySnapshot expected = sample(i, t);
+                exact = exact && std::fabs(lats[r] - expected.latitude) < 1e-7
+                              && std::fabs(alts[r] - expected.altitude) < 1e-3
+                              && std::fabs(headings[r] - expected.heading) < 1e-2;
+                bounded = bounded && ids[r] >= reader.chunk(g, drone).min && ids[r] <= reader.chunk(g, drone).max;
+                if (r > 0) {
+                    bounded = bounded && (ids[r] > ids[r - 1] || (ids[r] == ids[r - 1] && times[r] >= times[r - 1]));
+                }
+            }
+        }
+        QVERIFY2(exact, "Values survive the integer scaling");
+        QVERIFY2(bounded, "Rows are ordered by drone then time, inside the chunk min/max");
+        QVERIFY(std::count(seen.begin(), seen.end(), 1) == drones * ticks);
+        std::remove(path.c_str());
+    }
+
+    void test_statistics_skip_row_groups() {
+        const std::string path = tempPath("pushdown");
+        {
+            ColumnarRecorder recorder;
+            QVERIFY(recorder.open(QString::fromUtf8(path.c_str()), 500, 20));
+            recordRun(recorder, 500, 20); // one row group per tick, altitude = 10 * tick
+        }
+
+        ColumnarReader reader;
+        QVERIFY(reader.open(path));
+        const int alt = reader.findColumn("altitude");
+        QCOMPARE(reader.rowGroupCount(), 20);
+
+        int candidates = 0;
+        for (int g = 0; g < reader.rowGroupCount(); ++g) {
+            candidates += reader.mayContain(g, alt, 69.0, 71.0) ? 1 : 0;
+        }
+        QCOMPARE(candidates, 1);
+        QVERIFY(reader.mayContain(7, alt, 69.0, 71.0));
+        std::remove(path.c_str());
+    }
+
+    void test_compression_beats_raw_columns() {
+        const std::string path = tempPath("size");
+        std::uint64_t bytes = 0;
+        const int drones = 2000, ticks = 30;
+        {
+            ColumnarRecorder recorder;
+            QVERIFY(recorder.open(QString::fromUtf8(path.c_str()), 65536, 1));
+            recordRun(recorder, drones, ticks);
+            recorder.close();
+            bytes = recorder.bytesWritten();
+        }
+
+        // 9 columns of 8 bytes per row uncompressed
+        const std::uint64_t raw = std::uint64_t(drones) * ticks * 9 * 8;
+        QVERIFY2(bytes * 4 < raw, qPrintable(QString("%1 bytes vs %2 raw").arg(bytes).arg(raw)));
+        QCOMPARE(std::uint64_t(std::filesystem::file_size(path)), bytes);
+        std::remove(path.c_str());
+    }
+
+    void test_full_pool_drops_instead_of_blocking() {
+        const std::string path = tempPath("drops");
+        ColumnarRecorder recorder;
+        QVERIFY(recorder.open(QString::fromUtf8(path.c_str()), 16, 1));
+
+        const auto start = std::chrono::steady_clock::now();
+        for (int n = 0; n < 200000; ++n) {
+            recorder.record(n % 100, sample(n % 100, n / 100));
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        recorder.close();
+
+        QVERIFY(recorder.rowsDropped() > 0);
+        QCOMPARE(recorder.rowsRecorded() + recorder.rowsDropped(), std::uint64_t(200000));
+        QVERIFY(elapsed < std::chrono::seconds(2));
+        std::remove(path.c_str());
+    }
+
+    void test_unfinished_file_is_rejected() {
+        const std::string path = tempPath("truncated");
+        {
+            ColumnarRecorder recorder;
+            QVERIFY(recorder.open(QString::fromUtf8(path.c_str()), 256));
+            recordRun(recorder, 100, 10);
+        }
+        std::filesystem::resize_file(path, std::filesystem::file_size(path) - 3);
+
+        ColumnarReader reader;
+        std::string error;
+        QVERIFY(!reader.open(path, &error));
+        QVERIFY(!error.empty());
+        QVERIFY(!reader.isOpen());
+        std::remove(path.c_str());
+    }
+};
+
+QTEST_MAIN(TestColumnar)
+#include "test_columnar.moc"
@@ -0,0 +1,87 @@
+#include <QtTest>
+
+#include <thread>
+#include <vector>
+
+#include "../CommandQueue.h"
+
+class TestCommandQueue : public QObject {
+    Q_OBJECT
+
+private slots:
+
+    void test_fifo_order() {
+        CommandQueue q(8);
+
+        for (int i = 0; i < 5; ++i) {
+            QVERIFY(q.push(FleetCommand::overrideSpeed(i, FleetCommand::Scope::Drone, i)));
+        }
+
+        FleetCommand cmd;
+        for (int i = 0; i < 5; ++i) {
+            QVERIFY(q.pop(cmd));
+            QCOMPARE(cmd.target, i);
+            QVERIFY(cmd.type == FleetCommand::Type::OverrideSpeed);
+        }
+
+        QVERIFY2(!q.pop(cmd), "Queue must be empty after draining every command");
+    }
+
+    void test_full_queue_rejects() {
+        CommandQueue q(4);
+
+        for (std::size_t i = 0; i < q.capacity(); ++i) {
+            QVERIFY(q.push(FleetCommand::pause()));
+        }
+
+        QVERIFY2(!q.push(FleetCommand::resume()), "Push into a full queue must fail");
+        QCOMPARE(q.dropped(), std::size_t(1));
+
+        // one pop frees exactly one slot
+        FleetCommand cmd;
+        QVERIFY(q.pop(cmd));
+        QVERIFY(q.push(FleetCommand::resume()));
+    }
+
+    void test_concurrent_producers() {
+        CommandQueue q(1024);
+
+        const int producers = 4;
+        const int perProducer = 20000;
+
+        std::vector<std::thread> threads;
+        for (int p = 0; p < producers; ++p) {
+            threads.emplace_back([&q, p]() {
+                for (int i = 0; i < perProducer; ++i) {
+                    // spin until the consumer makes room
+                    while (!q.push(FleetCommand::overrideAltitude(i, FleetCommand::Scope::Drone, p))) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+
+        // every producer's commands must arrive complete and in its own order
+        std::vector<int> next(producers, 0);
+        int received = 0;
+        FleetCommand cmd;
+        while (received < producers * perProducer) {
+            if (!q.pop(cmd)) {
+                std::this_thread::yield();
+                continue;
+            }
+            QCOMPARE(int(cmd.value), next[cmd.target]);
+            ++next[cmd.target];
+            ++received;
+        }
+
+        for (auto &t : threads) {
+            t.join();
+        }
+
+        QVERIFY(!q.pop(cmd));
+    }
+};
+
+QTEST_MAIN(TestCommandQueue)
+#include "test_commandqueue.moc"
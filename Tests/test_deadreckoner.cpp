@@ -0,0 +1,116 @@
+#include <QtTest>
+
+#include <algorithm>
+#include <cmath>
+
+#include "../DeadReckoner.h"
+#include "../EnuFrame.h"
+
+class TestDeadReckoner : public QObject {
+    Q_OBJECT
+
+private:
+    // sample of drone D-1 at east/north meters from (28.6, 77.2)
+    static TelemetrySnapshot sample(double east, double north, double heading, double speed, qint64 t, double altitude = 50.0) {
+        TelemetrySnapshot snap;
+        snap.id = "D-1";
+        EnuFrame(28.6, 77.2).toGeodetic(east, north, snap.latitude, snap.longitude);
+        snap.altitude = altitude;
+        snap.heading = heading;
+        snap.speed = speed;
+        snap.timestampMs = t;
+        return snap;
+    }
+
+    static void shown(const DeadReckoner &dr, double &east, double &north) {
+        const TelemetrySnapshot s = dr.displayed(0);
+        EnuFrame(28.6, 77.2).toEnu(s.latitude, s.longitude, east, north);
+    }
+
+private slots:
+
+    void test_first_sample_is_shown_as_is() {
+        DeadReckoner dr;
+        QCOMPARE(dr.update(sample(0, 0, 0, 0, 1000), 1000), 0);
+        QCOMPARE(dr.find("D-1"), 0);
+        QCOMPARE(dr.find("D-2"), -1);
+        dr.advance(1000);
+
+        double e = 1, n = 1;
+        shown(dr, e, n);
+        QVERIFY(std::fabs(e) < 1e-6 && std::fabs(n) < 1e-6);
+        QCOMPARE(dr.displayed(0).battery, 100);
+    }
+
+    void test_extrapolates_along_heading() {
+        DeadReckoner dr;
+        dr.update(sample(0, 0, 90.0, 10.0, 0), 0); // east at 10 m/s
+        dr.advance(250);
+
+        double e = 0, n = 0;
+        shown(dr, e, n);
+        QVERIFY2(std::fabs(e - 2.5) < 1e-3, "Quarter second at 10 m/s is 2.5 m");
+        QVERIFY(std::fabs(n) < 1e-3);
+    }
+
+    void test_new_sample_does_not_jump() {
+        DeadReckoner dr;
+        dr.update(sample(0, 0, 0.0, 10.0, 0), 0); // north at 10 m/s
+        dr.advance(500);
+        double e0 = 0, n0 = 0;
+        shown(dr, e0, n0);
+        QVERIFY(std::fabs(n0 - 5.0) < 1e-3);
+
+        // the drone actually turned east: the next sample is 3 m off the drawn path
+        dr.update(sample(3.0, 5.0, 90.0, 10.0, 500), 500);
+        dr.advance(500);
+        double e1 = 0, n1 = 0;
+        shown(dr, e1, n1);
+        QVERIFY2(std::hypot(e1 - e0, n1 - n0) < 1e-6, "The display continues from where it was drawn");
+
+        // small steps per 60 fps frame while blending
+        double pe = e1, pn = n1, worst = 0.0;
+        for (qint64 t = 516; t <= 1000; t += 16) {
+            dr.advance(t);
+            double e = 0, n = 0;
+            shown(dr, e, n);
+            worst = std::max(worst, std::hypot(e - pe, n - pn));
+            pe = e;
+            pn = n;
+        }
+        QVERIFY2(worst < 0.5, "No frame moves more than a smooth step");
+
+        // after one sample interval the track is on the new dead-reckoned path
+        dr.advance(1000);
+        shown(dr, pe, pn);
+        QVERIFY(std::fabs(pe - 8.0) < 1e-3 && std::fabs(pn - 5.0) < 1e-3);
+    }
+
+    void test_heading_and_altitude_blend() {
+        DeadReckoner dr;
+        dr.update(sample(0, 0, 350.0, 0.0, 0, 50.0), 0);
+        dr.advance(0);
+        dr.update(sample(0, 0, 10.0, 0.0, 500, 60.0), 0);
+
+        dr.advance(250);
+        QVERIFY2(std::fabs(dr.displayed(0).heading - 0.0) < 1e-6 || std::fabs(dr.displayed(0).heading - 360.0) < 1e-6,
+                 "Heading turns the short way across north");
+
+        // climb rate from the last two samples: 10 m per 500 ms
+        dr.advance(1000);
+        QVERIFY(std::fabs(dr.displayed(0).altitude - 80.0) < 1e-6);
+    }
+
+    void test_silent_drone_stops() {
+        DeadReckoner dr;
+        dr.setMaxExtrapolationMs(1000);
+        dr.update(sample(0, 0, 0.0, 10.0, 0), 0);
+        dr.advance(5000);
+        double e = 0, n = 0;
+        shown(dr, e, n);
+        QVERIFY2(std::fabs(n - 10.0) < 1e-3, "Extrapolation ends at the limit");
+    }
+};
+
+QTEST_MAIN(TestDeadReckoner)
+#include "test_deadreckoner.moc"
@@ -0,0 +1,131 @@
+#include <QtTest>
+
+#include <cmath>
+
+#include "../DerivedMetrics.h"
+#include "../EnuFrame.h"
+
+class TestDerivedMetrics : public QObject {
+    Q_OBJECT
+
+private:
+    // sample of drone D-1 at east/north meters from (28.6, 77.2)
+    static TelemetrySnapshot sample(double east, double north, qint64 t, double speed = 0.0, int battery = 100, double altitude = 50.0) {
+        TelemetrySnapshot snap;
+        snap.id = "D-1";
+        EnuFrame(28.6, 77.2).toGeodetic(east, north, snap.latitude, snap.longitude);
+        snap.altitude = altitude;
+        snap.speed = speed;
+        snap.battery = battery;
+        snap.timestampMs = t;
+        return snap;
+    }
+
+private slots:
+
+    void test_distance_and_path_length() {
+        DerivedMetrics dm;
+        dm.subscribe(DerivedMetric::DistanceToHome);
+        dm.subscribe(DerivedMetric::PathLength);
+
+        // out 100 m north, 100 m east, back home: a 400 m path ending at the launch point
+        const double corners[][2] = {{0, 0}, {0, 100}, {100, 100}, {100, 0}, {0, 0}};
+        for (int i = 0; i < 5; ++i) {
+            dm.update(sample(corners[i][0], corners[i][1], 1000 * i));
+            if (i == 2) {
+                QVERIFY(std::fabs(dm.value("D-1", DerivedMetric::DistanceToHome) - 100.0 * std::sqrt(2.0)) < 0.01);
+            }
+        }
+        QVERIFY(std::fabs(dm.value("D-1", DerivedMetric::PathLength) - 400.0) < 0.01);
+        QVERIFY(dm.value("D-1", DerivedMetric::DistanceToHome) < 0.01);
+
+        // climbing counts toward the path
+        dm.update(sample(0, 0, 6000, 0.0, 100, 80.0));
+        QVERIFY(std::fabs(dm.value("D-1", DerivedMetric::PathLength) - 430.0) < 0.01);
+    }
+
+    void test_only_subscribed_metrics_are_computed() {
+        DerivedMetrics dm;
+        dm.update(sample(0, 0, 0));
+        dm.update(sample(0, 50, 1000));
+        for (int m = 0; m < DerivedMetric::Count; ++m) {
+            QVERIFY(std::isnan(dm.value(0, m)));
+        }
+
+        // a late subscription starts from the next sample; the launch point is still the first sample
+        dm.subscribe(DerivedMetric::PathLength);
+        dm.subscribe(DerivedMetric::TimeToHome); // pulls in distance and speed
+        QVERIFY(dm.subscribed(DerivedMetric::TimeToHome));
+        QVERIFY(!dm.subscribed(DerivedMetric::DistanceToHome));
+        dm.update(sample(0, 60, 2000, 5.0));
+        dm.update(sample(0, 70, 4000, 5.0));
+        QVERIFY(std::fabs(dm.value(0, DerivedMetric::PathLength) - 10.0) < 0.01);
+        QVERIFY(std::fabs(dm.value(0, DerivedMetric::DistanceToHome) - 70.0) < 0.01);
+        QVERIFY(std::fabs(dm.value(0, DerivedMetric::TimeToHome) - 14.0) < 0.01);
+        QVERIFY(std::isnan(dm.value(0, DerivedMetric::RemainingFlightTime)));
+
+        // the last subscription gone, the metric stops
+        dm.unsubscribe(DerivedMetric::PathLength);
+        QVERIFY(std::isnan(dm.value(0, DerivedMetric::PathLength)));
+        QVERIFY(std::isnan(dm.value("D-2", DerivedMetric::TimeToHome)));
+    }
+
+    void test_remaining_flight_time_from_battery_trend() {
+        DerivedMetrics dm;
+        dm.subscribe(DerivedMetric::RemainingFlightTime);
+
+        // 1% every 10 s, sampled every second (integer percent steps)
+        for (int s = 0; s <= 200; ++s) {
+            dm.update(sample(0, 0, 1000LL * s, 0.0, 100 - s / 10));
+        }
+        const double remaining = dm.value(0, DerivedMetric::RemainingFlightTime);
+        QVERIFY2(std::fabs(remaining - 800.0) < 40.0, "80% left at 0.1%/s is about 800 s");
+
+        // a battery that stops draining has no limit
+        DerivedMetrics flat;
+        flat.subscribe(DerivedMetric::RemainingFlightTime);
+        for (int s = 0; s <= 20; ++s) {
+            flat.update(sample(0, 0, 1000LL * s, 0.0, 90));
+        }
+        QVERIFY(std::isinf(flat.value(0, DerivedMetric::RemainingFlightTime)));
+    }
+
+    void test_ground_speed_window() {
+        DerivedMetrics dm;
+        dm.setSpeedWindowSeconds(10.0);
+        dm.subscribe(DerivedMetric::GroundSpeedAverage);
+
+        dm.update(sample(0, 0, 0, 0.0));
+        for (int s = 1; s <= 10; ++s) {
+            dm.update(sample(0, 0, 1000LL * s, 10.0));
+        }
+        // one window after a step the average is 1 - 1/e of the way there, at any sample rate
+        QVERIFY(std::fabs(dm.value(0, DerivedMetric::GroundSpeedAverage) - 10.0 * (1.0 - std::exp(-1.0))) < 1e-9);
+
+        DerivedMetrics coarse;
+        coarse.setSpeedWindowSeconds(10.0);
+        coarse.subscribe(DerivedMetric::GroundSpeedAverage);
+        coarse.update(sample(0, 0, 0, 0.0));
+        coarse.update(sample(0, 0, 5000, 10.0));
+        coarse.update(sample(0, 0, 10000, 10.0));
+        QVERIFY(std::fabs(coarse.value(0, DerivedMetric::GroundSpeedAverage) - dm.value(0, DerivedMetric::GroundSpeedAverage)) < 1e-9);
+    }
+
+    void test_remaining_range() {
+        DerivedMetrics dm;
+        dm.subscribe(DerivedMetric::RemainingRange);
+
+        for (int s = 0; s <= 200; ++s) {
+            dm.update(sample(0, 8.0 * s, 1000LL * s, 8.0, 100 - s / 10));
+        }
+        const double time = dm.value(0, DerivedMetric::RemainingFlightTime);
+        QVERIFY(std::fabs(dm.value(0, DerivedMetric::RemainingRange) - 8.0 * time) < 1e-6);
+
+        // hovering: no range, whatever the battery
+        dm.update(sample(0, 1600, 1000 * 1000, 0.0, 70));
+        QVERIFY(dm.value(0, DerivedMetric::RemainingRange) < 8.0 * time);
+    }
+};
+
+QTEST_MAIN(TestDerivedMetrics)
+#include "test_derivedmetrics.moc"
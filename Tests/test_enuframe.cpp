@@ -0,0 +1,65 @@
+#include <QtTest>
+
+#include <cmath>
+
+#include "../EnuFrame.h"
+#include "../FastTrig.h"
+
+class TestEnuFrame : public QObject {
+    Q_OBJECT
+
+private slots:
+
+    void test_round_trip() {
+        EnuFrame frame(28.6139, 77.2090);
+
+        double lat, lon, east, north;
+        frame.toGeodetic(1234.5, -987.25, lat, lon);
+        frame.toEnu(lat, lon, east, north);
+
+        QVERIFY(std::fabs(east - 1234.5) < 1e-6);
+        QVERIFY(std::fabs(north + 987.25) < 1e-6);
+    }
+
+    void test_scale_matches_wgs84() {
+        // one degree of latitude is ~110.57 km at the equator and ~111.69 km at the poles
+        EnuFrame equator(0.0, 0.0);
+        QVERIFY(std::fabs(equator.metersPerDegreeLatitude() - 110574.0) < 5.0);
+        QVERIFY(std::fabs(equator.metersPerDegreeLongitude() - 111320.0) < 5.0);
+
+        // one degree of longitude shrinks with cos(latitude)
+        EnuFrame sixty(60.0, 10.0);
+        QVERIFY(std::fabs(sixty.metersPerDegreeLongitude() - 55800.0) < 50.0);
+
+        // poles stay finite
+        EnuFrame pole(90.0, 0.0);
+        QVERIFY(std::isfinite(1.0 / pole.metersPerDegreeLongitude()));
+    }
+
+    void test_fast_sincos_accuracy() {
+        double worst = 0.0;
+        for (double x = -2000.0; x < 2000.0; x += 0.00731) {
+            double s, c;
+            FastTrig::sinCos(x, s, c);
+            worst = std::max(worst, std::fabs(s - std::sin(x)));
+            worst = std::max(worst, std::fabs(c - std::cos(x)));
+        }
+        QVERIFY2(worst < 2e-9, "sinCos must stay within 2e-9 of std::sin/cos");
+    }
+
+    void test_fast_atan2_accuracy() {
+        double worst = 0.0;
+        for (double a = -3.14; a < 3.14; a += 0.0013) {
+            for (double r : {1e-3, 1.0, 250.0}) {
+                const double y = r * std::sin(a);
+                const double x = r * std::cos(a);
+                worst = std::max(worst, std::fabs(FastTrig::atan2(y, x) - std::atan2(y, x)));
+            }
+        }
+        QVERIFY2(worst < 2e-6, "atan2 must stay within 2e-6 rad of std::atan2");
+        QCOMPARE(FastTrig::atan2(0.0, 0.0), 0.0);
+    }
+};
+
+QTEST_MAIN(TestEnuFrame)
+#include "test_enuframe.moc"
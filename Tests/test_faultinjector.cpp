@@ -0,0 +1,110 @@
+#include <QtTest>
+
+#include "../FaultInjector.h"
+#include "fleetfixture.h"
+
+class TestFaultInjector : public QObject {
+    Q_OBJECT
+
+private slots:
+
+    void test_no_faults_keeps_state() {
+        FleetState fleet = makeFleet(1000);
+        FaultInjector faults(42);
+        faults.setFleetProfile(FaultProfile::none());
+        faults.resize(fleet.size());
+
+        for (int tick = 0; tick < 100; ++tick) {
+            faults.step(fleet, 0.5);
+        }
+
+        for (int i = 0; i < fleet.size(); ++i) {
+            QVERIFY(fleet.gpsFix[i] == TelemetrySnapshot::GpsFix::Fix3D);
+            QCOMPARE(fleet.battery[i], 100);
+            QVERIFY(!faults.linkLost(i));
+        }
+    }
+
+    void test_failure_mode_forces_no_fix() {
+        FleetState fleet = makeFleet(10);
+        FaultInjector faults(42);
+        faults.setFleetProfile(FaultProfile::none());
+        faults.resize(fleet.size());
+
+        fleet.failure[3] = 1;
+        faults.step(fleet, 0.5);
+
+        QVERIFY(fleet.gpsFix[3] == TelemetrySnapshot::GpsFix::NoFix);
+        QVERIFY(fleet.gpsFix[4] == TelemetrySnapshot::GpsFix::Fix3D);
+    }
+
+    void test_paused_drones_are_frozen() {
+        FleetState fleet = makeFleet(200);
+        FaultInjector faults(42);
+        faults.setFleetProfile(FaultProfile::stress());
+        faults.resize(fleet.size());
+
+        for (int i = 0; i < fleet.size(); i += 2) {
+            fleet.paused[i] = 1;
+        }
+        for (int tick = 0; tick < 200; ++tick) {
+            faults.step(fleet, 0.5);
+        }
+
+        int changed = 0;
+        for (int i = 0; i < fleet.size(); ++i) {
+            const bool untouched = fleet.gpsFix[i] == TelemetrySnapshot::GpsFix::Fix3D && fleet.battery[i] == 100 && !faults.linkLost(i);
+            if (fleet.paused[i]) {
+                QVERIFY(untouched);
+            } else if (!untouched) {
+                ++changed;
+            }
+        }
+        QVERIFY(changed > 50); // the running half did see faults
+    }
+
+    void test_dropout_rate_and_duration() {
+        // only GPS dropouts: expected NoFix share = rate * mean / (1 + rate * mean)
+        FaultProfile p = FaultProfile::none();
+        p.gpsDropoutRate = 0.1;
+        p.gpsDropoutMeanSec = 5.0;
+
+        FleetState fleet = makeFleet(10000);
+        FaultInjector faults(7);
+        faults.setFleetProfile(p);
+        faults.resize(fleet.size());
+
+        for (int tick = 0; tick < 400; ++tick) {
+            faults.step(fleet, 0.1);
+        }
+
+        int noFix = 0;
+        for (int i = 0; i < fleet.size(); ++i) {
+            noFix += fleet.gpsFix[i] == TelemetrySnapshot::GpsFix::NoFix ? 1 : 0;
+        }
+
+        const double share = double(noFix) / fleet.size();
+        QVERIFY2(share > 0.25 && share < 0.42, "Steady-state NoFix share should be close to 1/3");
+    }
+
+    void test_per_drone_profile() {
+        FleetState fleet = makeFleet(100);
+        FaultInjector faults(3);
+        faults.setFleetProfile(FaultProfile::none());
+
+        FaultProfile lossy = FaultProfile::none();
+        lossy.linkLossRate = 1000.0; // practically certain within one tick
+        lossy.linkLossMeanSec = 1000.0;
+        const int lossyIndex = faults.addProfile(lossy);
+
+        faults.resize(fleet.size());
+        faults.assignProfile(5, lossyIndex);
+        faults.step(fleet, 0.5);
+
+        QVERIFY(faults.linkLost(5));
+        QVERIFY(!faults.linkLost(6));
+    }
+};
+
+QTEST_MAIN(TestFaultInjector)
+#include "test_faultinjector.moc"
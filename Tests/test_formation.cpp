@@ -0,0 +1,169 @@
+#include <QtTest>
+
+#include <cmath>
+#include <vector>
+
+#include "../FormationStrategy.h"
+#include "../FleetState.h"
+
+class TestFormation : public QObject {
+    Q_OBJECT
+
+private:
+    // Leader at index 0 plus `followers` drones of group 0 scattered near the origin.
+    static FleetState makeGroup(int followers) {
+        FleetState fleet;
+        fleet.add("LEAD", 0, 0);
+        fleet.altitude[0] = 50.0;
+        for (int i = 1; i <= followers; ++i) {
+            fleet.add(QString("F-%1").arg(i), 0, 0);
+            fleet.east[i] = 3.0 * (i % 4) - 4.0;
+            fleet.north[i] = -2.0 * (i / 4);
+            fleet.altitude[i] = 20.0;
+        }
+        return fleet;
+    }
+
+    static std::vector<int> allMembers(const FleetState &fleet) {
+        std::vector<int> members;
+        for (int i = 0; i < fleet.size(); ++i) {
+            members.push_back(i);
+        }
+        return members;
+    }
+
+    // Distance from follower i to its slot behind leader 0.
+    static double slotError(const FormationStrategy &strat, const FleetState &fleet, int i, int rank) {
+        double forward, right;
+        strat.slotOffset(rank, forward, right);
+        const double h = fleet.heading[0] * M_PI / 180.0;
+        const double te = fleet.east[0] + forward * std::sin(h) + right * std::cos(h);
+        const double tn = fleet.north[0] + forward * std::cos(h) - right * std::sin(h);
+        return std::hypot(fleet.east[i] - te, fleet.north[i] - tn);
+    }
+
+private slots:
+
+    void test_followers_converge_to_slots() {
+        FormationConfig cfg;
+        cfg.columns = 3;
+        FormationStrategy strat(cfg);
+
+        FleetState fleet = makeGroup(7);
+        const std::vector<int> members = allMembers(fleet);
+        for (int tick = 0; tick < 200; ++tick) {
+            strat.stepBatch(fleet, members, 0.1);
+        }
+
+        QCOMPARE(strat.leaderOf(0), 0);
+        QVERIFY2(std::fabs(fleet.speed[0] - cfg.leaderSpeed) < 1e-9, "The leader cruises at leaderSpeed");
+        for (int i = 1; i <= 7; ++i) {
+            QVERIFY2(slotError(strat, fleet, i, i - 1) < 0.05, "Followers must settle in their grid slot");
+            QVERIFY2(std::fabs(fleet.altitude[i] - fleet.altitude[0]) < 0.05, "Followers must match the leader's altitude");
+            QVERIFY2(std::fabs(fleet.speed[i] - cfg.leaderSpeed) < 0.05, "Followers must match the leader's speed");
+        }
+
+        // first row is one spacing behind the leader, centered on its track
+        double forward, right;
+        strat.slotOffset(1, forward, right);
+        QCOMPARE(forward, -cfg.spacing);
+        QCOMPARE(right, 0.0);
+    }
+
+    void test_result_independent_of_member_order() {
+        FormationStrategy a, b;
+        FleetState fleetA = makeGroup(12);
+        FleetState fleetB = makeGroup(12);
+        const std::vector<int> forward = allMembers(fleetA);
+        const std::vector<int> shuffled = {7, 0, 12, 3, 9, 1, 11, 5, 2, 10, 4, 8, 6};
+
+        for (int tick = 0; tick < 30; ++tick) {
+            a.stepBatch(fleetA, forward, 0.1);
+            b.stepBatch(fleetB, shuffled, 0.1);
+        }
+        for (int i = 0; i < fleetA.size(); ++i) {
+            QCOMPARE(fleetA.east[i], fleetB.east[i]);
+            QCOMPARE(fleetA.north[i], fleetB.north[i]);
+            QCOMPARE(fleetA.altitude[i], fleetB.altitude[i]);
+            QCOMPARE(fleetA.heading[i], fleetB.heading[i]);
+        }
+    }
+
+    void test_grid_rotates_with_leader_heading() {
+        FormationConfig cfg;
+        cfg.columns = 1;
+        FormationStrategy strat(cfg);
+
+        FleetState fleet = makeGroup(1);
+        fleet.heading[0] = 90.0; // leader flies east
+        const std::vector<int> members = allMembers(fleet);
+        for (int tick = 0; tick < 200; ++tick) {
+            strat.stepBatch(fleet, members, 0.1);
+        }
+
+        // the single follower trails directly west of the leader
+        QVERIFY(std::fabs(fleet.north[1] - fleet.north[0]) < 0.05);
+        QVERIFY(std::fabs((fleet.east[0] - fleet.east[1]) - cfg.spacing) < 0.05);
+        QVERIFY(std::fabs(fleet.heading[1] - 90.0) < 0.5);
+    }
+
+    void test_close_neighbors_push_apart() {
+        FormationConfig cfg;
+        cfg.positionGain = 0.0; // separation only
+        cfg.leaderSpeed = 0.0;
+        FormationStrategy strat(cfg);
+
+        FleetState fleet;
+        fleet.add("LEAD", 0, 0);
+        fleet.north[0] = 100.0;
+        fleet.add("F-1", 0, 0);
+        fleet.add("F-2", 0, 0);
+        fleet.east[2] = 1.0;
+        const std::vector<int> members = {0, 1, 2};
+
+        strat.stepBatch(fleet, members, 0.1);
+        QVERIFY2(fleet.east[1] < 0.0 && fleet.east[2] > 1.0, "Neighbors inside the separation distance must move apart");
+        QCOMPARE(fleet.east[1] + fleet.east[2], 1.0); // symmetric push
+    }
+
+    void test_explicit_leader() {
+        FormationStrategy strat;
+        FleetState fleet = makeGroup(3);
+        const std::vector<int> members = {1, 2, 3}; // drone 0 flown by another strategy
+
+        strat.setLeader(0, 2);
+        strat.stepBatch(fleet, members, 0.1);
+        QCOMPARE(strat.leaderOf(0), 2);
+        QCOMPARE(fleet.speed[2], FormationConfig().leaderSpeed);
+
+        // drone 0 is a follower now and keeps its position (not in members)
+        QCOMPARE(fleet.east[0], 0.0);
+
+        strat.setLeader(0, -1);
+        strat.stepBatch(fleet, members, 0.1);
+        QCOMPARE(strat.leaderOf(0), 0);
+        QCOMPARE(strat.leaderOf(5), -1);
+    }
+
+    void test_leader_from_another_group_is_ignored() {
+        FormationStrategy strat;
+        FleetState fleet = makeGroup(3);
+        fleet.add("OTHER", 1, 0);
+        const std::vector<int> members = allMembers(fleet);
+
+        // drone 4 flies in group 1: group 0 keeps its default leader, drone 4 leads its own group
+        strat.setLeader(0, 4);
+        strat.stepBatch(fleet, members, 0.1);
+        QCOMPARE(strat.leaderOf(0), 0);
+        QCOMPARE(strat.leaderOf(1), 4);
+
+        // regrouped into group 0, the explicit choice takes effect
+        fleet.group[4] = 0;
+        strat.stepBatch(fleet, members, 0.1);
+        QCOMPARE(strat.leaderOf(0), 4);
+        QCOMPARE(strat.leaderOf(1), -1);
+    }
+};
+
+QTEST_MAIN(TestFormation)
+#include "test_formation.moc"
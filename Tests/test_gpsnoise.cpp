@@ -0,0 +1,114 @@
+#include <QtTest>
+
+#include <cmath>
+#include <vector>
+
+#include "../FastRandom.h"
+#include "../GpsNoiseModel.h"
+#include "fleetfixture.h"
+
+class TestGpsNoise : public QObject {
+    Q_OBJECT
+
+private slots:
+
+    void test_gaussian_moments() {
+        FastRandom rng(11);
+        const int N = 1000000;
+        std::vector<double> v(N);
+        rng.fillGaussian(v.data(), N);
+
+        double mean = 0.0, var = 0.0, beyond3 = 0.0;
+        for (double x : v) {
+            mean += x;
+            var += x * x;
+            beyond3 += std::fabs(x) > 3.0 ? 1.0 : 0.0;
+        }
+        mean /= N;
+        var /= N;
+        beyond3 /= N;
+
+        QVERIFY2(std::fabs(mean) < 0.01, "Gaussian mean must be ~0");
+        QVERIFY2(std::fabs(var - 1.0) < 0.01, "Gaussian variance must be ~1");
+        QVERIFY2(beyond3 > 0.0022 && beyond3 < 0.0032, "Tail mass beyond 3 sigma must be ~0.27%");
+    }
+
+    void test_stationary_sigma_follows_hdop() {
+        GpsNoiseConfig cfg;
+        cfg.multipathRate = 0.0;
+        cfg.correlationSec = 2.0;
+
+        FleetState fleet = makeFleet(20000);
+        GpsNoiseModel noise(5);
+        noise.setConfig(cfg);
+        noise.resize(fleet.size());
+
+        // first half 3D, second half 2D
+        for (int i = fleet.size() / 2; i < fleet.size(); ++i) {
+            fleet.gpsFix[i] = TelemetrySnapshot::GpsFix::Fix2D;
+        }
+
+        for (int tick = 0; tick < 100; ++tick) {
+            noise.step(fleet, 0.5);
+        }
+
+        double var3D = 0.0, var2D = 0.0;
+        const int half = fleet.size() / 2;
+        for (int i = 0; i < half; ++i) {
+            var3D += noise.errorNorth(i) * noise.errorNorth(i);
+            var2D += noise.errorNorth(half + i) * noise.errorNorth(half + i);
+        }
+
+        const double sigma3D = std::sqrt(var3D / half);
+        const double sigma2D = std::sqrt(var2D / half);
+
+        QVERIFY2(std::fabs(sigma3D - cfg.uereMeters * cfg.hdop3D) < 0.1, "3D sigma must equal UERE * HDOP");
+        QVERIFY2(std::fabs(sigma2D - cfg.uereMeters * cfg.hdop2D) < 0.2, "2D sigma must equal UERE * HDOP");
+    }
+
+    void test_error_is_correlated() {
+        GpsNoiseConfig cfg;
+        cfg.multipathRate = 0.0;
+        cfg.correlationSec = 60.0;
+
+        FleetState fleet = makeFleet(5000);
+        GpsNoiseModel noise(9);
+        noise.setConfig(cfg);
+        noise.resize(fleet.size());
+
+        for (int tick = 0; tick < 50; ++tick) {
+            noise.step(fleet, 0.5);
+        }
+
+        std::vector<double> before(fleet.size());
+        for (int i = 0; i < fleet.size(); ++i) {
+            before[i] = noise.errorEast(i);
+        }
+        noise.step(fleet, 0.5);
+
+        // lag-1 correlation of a Gauss-Markov process is exp(-dt / tau) ~ 0.99
+        double sxy = 0.0, sxx = 0.0;
+        for (int i = 0; i < fleet.size(); ++i) {
+            sxy += before[i] * noise.errorEast(i);
+            sxx += before[i] * before[i];
+        }
+        QVERIFY2(sxy / sxx > 0.95, "Consecutive errors must be strongly correlated");
+    }
+
+    void test_no_fix_holds_error() {
+        FleetState fleet = makeFleet(10);
+        GpsNoiseModel noise(1);
+        noise.resize(fleet.size());
+
+        noise.step(fleet, 0.5);
+        const double held = noise.errorNorth(0);
+
+        fleet.gpsFix[0] = TelemetrySnapshot::GpsFix::NoFix;
+        noise.step(fleet, 0.5);
+
+        QCOMPARE(noise.errorNorth(0), held);
+    }
+};
+
+QTEST_MAIN(TestGpsNoise)
+#include "test_gpsnoise.moc"
@@ -0,0 +1,246 @@
+#include <QtTest>
+
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <thread>
+#include <vector>
+
+#include "../MemoryAccounting.h"
+#include "../DroneSimulator.h"
+#include "../SimulatorFactory.h"
+#include "../FormationStrategy.h"
+
+class TestMemoryAccounting : public QObject {
+    Q_OBJECT
+
+private:
+    std::unique_ptr<int> m_held; // Keeps a test allocation observable (new/delete pairs may be elided).
+
+private slots:
+
+    void test_scope_charges_subsystem() {
+        if (!MemoryAccounting::hooksInstalled()) {
+            QSKIP("Built without the counting allocator");
+        }
+        const MemoryStats before = MemoryAccounting::stats(MemorySubsystem::Logger);
+
+        std::vector<char> *buffer;
+        {
+            MemoryScope scope(MemorySubsystem::Logger);
+            buffer = new std::vector<char>(4000);
+        }
+        const MemoryStats during = MemoryAccounting::stats(MemorySubsystem::Logger);
+        QCOMPARE(during.allocations - before.allocations, 2LL); // the vector and its storage
+        QVERIFY(during.liveBytes - before.liveBytes >= 4000);
+        QVERIFY(during.peakBytes >= during.liveBytes);
+
+        // freed outside the scope, still credited to the logger
+        delete buffer;
+        const MemoryStats after = MemoryAccounting::stats(MemorySubsystem::Logger);
+        QCOMPARE(after.liveBytes, before.liveBytes);
+        QCOMPARE(after.frees - before.frees, 2LL);
+        QCOMPARE(MemoryAccounting::currentSubsystem(), int(MemorySubsystem::Other));
+    }
+
+    void test_qt_strings_are_charged() {
+        if (!MemoryAccounting::hooksInstalled()) {
+            QSKIP("Built without the counting allocator");
+        }
+#ifndef __GLIBC__
+        QSKIP("Qt container buffers come from malloc, which is only replaced on glibc");
+#endif
+        const MemoryStats before = MemoryAccounting::stats(MemorySubsystem::Logger);
+        {
+            // built like a log entry: QString data lives in QArrayData, allocated with ::malloc
+            QString entry;
+            {
+                MemoryScope scope(MemorySubsystem::Logger);
+                entry = QString("2026-10-19T12:00:00 - ") + QString("x").repeated(500);
+            }
+            const MemoryStats during = MemoryAccounting::stats(MemorySubsystem::Logger);
+            QVERIFY(during.allocations > before.allocations);
+            QVERIFY(during.liveBytes - before.liveBytes >= 500);
+        }
+        QCOMPARE(MemoryAccounting::stats(MemorySubsystem::Logger).liveBytes, before.liveBytes);
+    }
+
+    void test_free_on_another_thread_credits_allocator() {
+        if (!MemoryAccounting::hooksInstalled()) {
+            QSKIP("Built without the counting allocator");
+        }
+        const long long before = MemoryAccounting::stats(MemorySubsystem::Events).liveBytes;
+
+        // allocated as an event on a worker thread, freed by the receiving thread
+        std::unique_ptr<TelemetrySnapshot> event;
+        std::thread producer([&event] {
+            MemoryScope scope(MemorySubsystem::Events);
+            event = std::make_unique<TelemetrySnapshot>();
+        });
+        producer.join();
+        QCOMPARE(MemoryAccounting::stats(MemorySubsystem::Events).liveBytes - before, (long long)sizeof(TelemetrySnapshot));
+
+        event.reset();
+        QCOMPARE(MemoryAccounting::stats(MemorySubsystem::Events).liveBytes, before);
+    }
+
+    void test_zero_allocation_ticks() {
+        if (!MemoryAccounting::hooksInstalled()) {
+            QSKIP("Built without the counting allocator");
+        }
+        MemoryAccounting::resetStatistics();
+        MemoryAccounting::setZeroAllocationTicks(true);
+
+        {
+            TickScope tick;
+        }
+        QCOMPARE(MemoryAccounting::zeroAllocationViolations(), 0LL);
+
+        {
+            TickScope tick;
+            MemoryScope scope(MemorySubsystem::Strategies);
+            m_held = std::make_unique<int>(1);
+        }
+        m_held.reset();
+        QCOMPARE(MemoryAccounting::zeroAllocationViolations(), 1LL);
+        QCOMPARE(MemoryAccounting::stats(MemorySubsystem::Strategies).lastTickAllocations, 1LL);
+        QCOMPARE(MemoryAccounting::ticks(), 2LL);
+
+        MemoryAccounting::setZeroAllocationTicks(false);
+    }
+
+    void test_steady_state_tick_does_not_allocate() {
+        if (!MemoryAccounting::hooksInstalled()) {
+            QSKIP("Built without the counting allocator");
+        }
+
+        // the simulator's own tick over a mixed fleet: every strategy, every fault chain, noise,
+        // deadbands, commands and the publish pass; nothing is connected to its signals
+        const int count = 2000;
+        DroneSimulator sim("steady");
+        SimulatorFactory::registerBuiltinStrategies(&sim);
+        for (int i = 0; i < count; ++i) {
+            sim.addDrone(QString("D%1").arg(i), i / 50, i % StrategyType::Count);
+        }
+        sim.faultInjector().setFleetProfile(FaultProfile::stress());
+
+        // operator traffic through the command queue, as in the application
+        auto tick = [&sim](int t) {
+            if (t % 5 == 0) {
+                const int group = (t / 5) % (count / 50);
+                sim.submitCommand(FleetCommand::setStrategy((t / 5) % StrategyType::Count, FleetCommand::Scope::Group, group));
+                sim.submitCommand(FleetCommand::overrideSpeed(3.0, FleetCommand::Scope::Group, group));
+                sim.submitCommand(FleetCommand::pause(FleetCommand::Scope::Drone, t));
+            } else if (t % 5 == 2) {
+                sim.submitCommand(FleetCommand::clearOverrides(FleetCommand::Scope::Fleet));
+                sim.submitCommand(FleetCommand::resume(FleetCommand::Scope::Drone, t - 2));
+            }
+            sim.advance(0.1, 100 * t);
+        };
+
+        // warm-up ticks size the scratch buffers
+        for (int t = 0; t < 5; ++t) {
+            tick(t);
+        }
+
+        MemoryAccounting::resetStatistics();
+        MemoryAccounting::setZeroAllocationTicks(true);
+        for (int t = 5; t < 50; ++t) {
+            tick(t);
+        }
+        MemoryAccounting::setZeroAllocationTicks(false);
+
+        for (int sub = 0; sub < MemorySubsystem::Count; ++sub) {
+            if (MemoryAccounting::stats(sub).allocations != 0) {
+                qWarning() << MemoryAccounting::name(sub) << "allocated during the steady-state tick";
+            }
+        }
+        QCOMPARE(MemoryAccounting::zeroAllocationViolations(), 0LL);
+        QCOMPARE(MemoryAccounting::ticks(), 45LL);
+    }
+
+    void test_formation_single_step_does_not_allocate() {
+        if (!MemoryAccounting::hooksInstalled()) {
+            QSKIP("Built without the counting allocator");
+        }
+        FormationStrategy formation;
+        TelemetrySnapshot snap;
+        snap.id = "F-1";
+        snap = formation.step(snap, 0.5); // builds the one-drone fleet
+
+        long long allocations = 0;
+        {
+            MemoryScope scope(MemorySubsystem::Simulator);
+            const long long before = MemoryAccounting::stats(MemorySubsystem::Simulator).allocations;
+            for (int t = 0; t < 20; ++t) {
+                snap = formation.step(snap, 0.5);
+            }
+            allocations = MemoryAccounting::stats(MemorySubsystem::Simulator).allocations - before;
+        }
+        QCOMPARE(allocations, 0LL);
+    }
+
+    void test_tick_arena_settles() {
+        AccountedResource upstream(MemorySubsystem::Simulator);
+        TickArena arena(1024, &upstream);
+        const long long base = MemoryAccounting::stats(MemorySubsystem::Simulator).allocations;
+
+        // the first tick outgrows the block and borrows from upstream
+        auto tick = [&arena] {
+            {
+                std::pmr::vector<double> scratch(&arena);
+                scratch.resize(4000);
+                std::pmr::vector<int> more(300, 1, &arena);
+            }
+            // only once nothing points into the arena any more
+            arena.rewind();
+        };
+        tick();
+        const long long afterFirst = MemoryAccounting::stats(MemorySubsystem::Simulator).allocations;
+        QVERIFY(afterFirst > base);
+        QVERIFY(arena.capacity() >= 4000 * sizeof(double));
+
+        // then the same tick fits the grown block
+        for (int t = 0; t < 10; ++t) {
+            tick();
+        }
+        QCOMPARE(MemoryAccounting::stats(MemorySubsystem::Simulator).allocations, afterFirst);
+        QVERIFY(arena.highWater() >= 4000 * sizeof(double) + 300 * sizeof(int));
+    }
+
+    void test_tick_arena_over_aligned_stays_flat() {
+        AccountedResource upstream(MemorySubsystem::Simulator);
+        TickArena arena(1024, &upstream);
+        const long long base = MemoryAccounting::stats(MemorySubsystem::Simulator).allocations;
+
+        // one cache-line-aligned block per tick, well within the first block
+        auto tick = [&arena] {
+            void *p = arena.allocate(64, 64);
+            QVERIFY(reinterpret_cast<std::uintptr_t>(p) % 64 == 0);
+            arena.rewind();
+        };
+        for (int t = 0; t < 50; ++t) {
+            tick();
+        }
+        QCOMPARE(arena.capacity(), std::size_t(1024));
+        QCOMPARE(MemoryAccounting::stats(MemorySubsystem::Simulator).allocations, base);
+    }
+
+    void test_pool_over_accounted_resource() {
+        AccountedResource upstream(MemorySubsystem::Model);
+        const MemoryStats before = MemoryAccounting::stats(MemorySubsystem::Model);
+        {
+            std::pmr::unsynchronized_pool_resource pool(&upstream);
+            std::pmr::vector<std::pmr::vector<int>> lists(&pool);
+            for (int i = 0; i < 100; ++i) {
+                lists.emplace_back(16, i);
+            }
+            QVERIFY(MemoryAccounting::stats(MemorySubsystem::Model).liveBytes > before.liveBytes);
+        }
+        // the pool returns everything to upstream when destroyed
+        QCOMPARE(MemoryAccounting::stats(MemorySubsystem::Model).liveBytes, before.liveBytes);
+    }
+};
+
+QTEST_MAIN(TestMemoryAccounting)
+#include "test_memoryaccounting.moc"
@@ -0,0 +1,154 @@
+#include <QtTest>
+
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "../PointMassStrategy.h"
+#include "../WindField.h"
+#include "../FleetState.h"
+
+class TestPointMass : public QObject {
+    Q_OBJECT
+
+private:
+    static std::shared_ptr<const WindField> uniformWind(double fromDeg, double speed) {
+        WindFieldConfig cfg;
+        cfg.baseFromDeg = fromDeg;
+        cfg.baseSpeed = speed;
+        cfg.shearExponent = 0.0;     // same speed at every height above ground
+        cfg.gustAmplitude = 0.0;
+        cfg.updraftAmplitude = 0.0;
+        return std::make_shared<const WindField>(cfg);
+    }
+
+private slots:
+
+    void test_wind_interpolation_is_trilinear() {
+        WindFieldConfig cfg;
+        cfg.cellsEast = 8;
+        cfg.cellsNorth = 8;
+        cfg.layers = 4;
+        WindField wind(cfg);
+
+        // halfway between two horizontal nodes the wind is their average
+        const double h = 2.0 * cfg.layerMeters;
+        double e0, n0, u0, e1, n1, u1, em, nm, um;
+        wind.sample(0.5 * cfg.cellMeters, 0.5 * cfg.cellMeters, h, e0, n0, u0);
+        wind.sample(1.5 * cfg.cellMeters, 0.5 * cfg.cellMeters, h, e1, n1, u1);
+        wind.sample(1.0 * cfg.cellMeters, 0.5 * cfg.cellMeters, h, em, nm, um);
+
+        QVERIFY(std::fabs(em - 0.5 * (e0 + e1)) < 1e-4);
+        QVERIFY(std::fabs(nm - 0.5 * (n0 + n1)) < 1e-4);
+
+        // batch and single lookups agree
+        std::vector<double> east = {0.0, 123.0, -4000.0}, north = {0.0, -77.0, 9000.0}, up = {5.0, 60.0, 500.0};
+        std::vector<double> we(3), wn(3), wu(3);
+        wind.sampleBatch(east.data(), north.data(), up.data(), 3, we.data(), wn.data(), wu.data());
+        for (int i = 0; i < 3; ++i) {
+            double e, n, u;
+            wind.sample(east[i], north[i], up[i], e, n, u);
+            QCOMPARE(e, we[i]);
+            QCOMPARE(n, wn[i]);
+        }
+    }
+
+    void test_wind_clamps_non_finite_positions() {
+        WindField wind;
+        const double nan = std::nan("");
+        const double inf = std::numeric_limits<double>::infinity();
+
+        // a diverged body or a bad override must not index outside the grid
+        double e, n, u, ce, cn, cu;
+        wind.sample(nan, -inf, nan, e, n, u);
+        wind.sample(-1e9, -1e9, -1e9, ce, cn, cu);
+        QCOMPARE(e, ce);
+        QCOMPARE(n, cn);
+        QCOMPARE(u, cu);
+
+        wind.sample(inf, inf, inf, e, n, u);
+        wind.sample(1e9, 1e9, 1e9, ce, cn, cu);
+        QCOMPARE(e, ce);
+        QCOMPARE(n, cn);
+    }
+
+    void test_acceleration_is_limited() {
+        PointMassConfig cfg;
+        cfg.headingWanderDeg = 0.0;
+        PointMassStrategy strat(nullptr, cfg);
+
+        FleetState fleet;
+        fleet.add("D-1", 0, 0);
+        fleet.altitude[0] = cfg.targetAltitude;
+        const std::vector<int> members = {0};
+
+        strat.stepBatch(fleet, members, 0.5);
+        QVERIFY2(fleet.speed[0] <= cfg.maxAccel * 0.5 + 1e-9, "Speed may not jump beyond maxAccel * dt");
+        QVERIFY(fleet.speed[0] > 0.0);
+
+        for (int tick = 0; tick < 60; ++tick) {
+            strat.stepBatch(fleet, members, 0.5);
+        }
+        QVERIFY2(std::fabs(fleet.speed[0] - cfg.cruiseSpeed) < 0.5, "Drone must settle at cruise speed");
+    }
+
+    void test_climbs_to_target_altitude() {
+        PointMassConfig cfg;
+        PointMassStrategy strat(nullptr, cfg);
+
+        FleetState fleet;
+        fleet.add("D-1", 0, 0);
+        const std::vector<int> members = {0};
+
+        strat.stepBatch(fleet, members, 0.5);
+        QVERIFY2(fleet.altitude[0] <= cfg.maxVerticalAccel * 0.5 * 0.5 + 1e-9, "Climb rate is limited by maxVerticalAccel");
+
+        for (int tick = 0; tick < 200; ++tick) {
+            strat.stepBatch(fleet, members, 0.5);
+        }
+        QVERIFY(std::fabs(fleet.altitude[0] - cfg.targetAltitude) < 1.0);
+    }
+
+    void test_wind_pushes_hovering_drone() {
+        PointMassConfig cfg;
+        cfg.cruiseSpeed = 0.0;
+        cfg.maxAccel = 0.5; // weak drone: cannot fully hold against the wind
+        PointMassStrategy strat(uniformWind(270.0, 10.0), cfg); // wind from the west
+
+        FleetState fleet;
+        fleet.add("D-1", 0, 0);
+        fleet.altitude[0] = cfg.targetAltitude;
+        const double startEast = fleet.east[0];
+        const std::vector<int> members = {0};
+
+        for (int tick = 0; tick < 20; ++tick) {
+            strat.stepBatch(fleet, members, 0.5);
+        }
+        QVERIFY2(fleet.east[0] > startEast, "A westerly wind must push the drone east");
+    }
+
+    void test_battery_follows_power_model() {
+        PointMassConfig cfg;
+        cfg.cruiseSpeed = 0.0;
+        cfg.headingWanderDeg = 0.0;
+        PointMassStrategy strat(nullptr, cfg);
+
+        FleetState fleet;
+        fleet.add("D-1", 0, 0);
+        fleet.altitude[0] = cfg.targetAltitude;
+        const std::vector<int> members = {0};
+
+        // hovering in calm air draws hoverPowerW: a tenth of the capacity takes capacity*0.1/P hours
+        const double seconds = cfg.batteryCapacityWh * 0.1 / cfg.hoverPowerW * 3600.0;
+        const int ticks = int(seconds / 0.5);
+        for (int tick = 0; tick < ticks; ++tick) {
+            strat.stepBatch(fleet, members, 0.5);
+        }
+        QVERIFY2(std::abs(fleet.battery[0] - 90) <= 1, "Hover drain must match hoverPowerW");
+        QVERIFY(strat.modelsBattery());
+    }
+};
+
+QTEST_MAIN(TestPointMass)
+#include "test_pointmass.moc"
@@ -0,0 +1,187 @@
+#include <QtTest>
+
+#include "../PublicationFilter.h"
+#include "fleetfixture.h"
+
+class TestPublicationFilter : public QObject {
+    Q_OBJECT
+
+private:
+    // evaluate + publish every passing drone, as DroneSimulator does
+    static int tick(PublicationFilter &filter, const FleetState &fleet, qint64 nowMs) {
+        const int passing = filter.evaluate(fleet, nowMs);
+        for (int i = 0; i < fleet.size(); ++i) {
+            if (filter.passes(i)) {
+                filter.markPublished(fleet, i, nowMs);
+            }
+        }
+        return passing;
+    }
+
+private slots:
+
+    void test_first_tick_publishes_everyone() {
+        FleetState fleet = makeFleet(100);
+        PublicationFilter filter;
+        filter.resize(fleet.size());
+
+        QCOMPARE(tick(filter, fleet, 1000), 100);
+        QCOMPARE(tick(filter, fleet, 1500), 0);
+        QCOMPARE(filter.suppressed(), 100ull);
+        QCOMPARE(filter.suppressionRatio(), 0.5);
+    }
+
+    void test_heartbeat_bounds_silence() {
+        FleetState fleet = makeFleet(1);
+        DeadbandConfig cfg;
+        cfg.heartbeatMs = 2000;
+        PublicationFilter filter;
+        filter.setConfig(cfg);
+        filter.resize(fleet.size());
+
+        tick(filter, fleet, 0);
+        QCOMPARE(tick(filter, fleet, 1999), 0);
+        QCOMPARE(tick(filter, fleet, 2000), 1);
+        QCOMPARE(tick(filter, fleet, 3999), 0);
+
+        // hover-like jitter below the deadband stays silent until the heartbeat
+        fleet.east[0] += 0.6;
+        fleet.altitude[0] += 0.3;
+        QCOMPARE(tick(filter, fleet, 3999), 0);
+        QCOMPARE(tick(filter, fleet, 4000), 1);
+    }
+
+    void test_each_field_deadband_publishes() {
+        FleetState fleet = makeFleet(8);
+        for (int i = 0; i < fleet.size(); ++i) {
+            fleet.heading[i] = 359.0;
+        }
+        fleet.addRegion(28.6, 77.2);
+
+        PublicationFilter filter;
+        filter.resize(fleet.size());
+        tick(filter, fleet, 0);
+
+        fleet.east[0] += 0.8;
+        fleet.north[0] += 0.7;              // 1.06 m horizontally
+        fleet.altitude[1] += 0.5;
+        fleet.heading[2] = 1.0;             // 2 degrees across north
+        fleet.speed[3] += 0.25;
+        fleet.battery[4] -= 1;
+        fleet.gpsFix[5] = TelemetrySnapshot::GpsFix::Fix2D;
+        fleet.region[6] = 1;
+        fleet.heading[7] = 0.5;             // 1.5 degrees: inside the deadband
+
+        QCOMPARE(filter.evaluate(fleet, 100), 7);
+        for (int i = 0; i < 7; ++i) {
+            QVERIFY2(filter.passes(i), qPrintable(QString("field change of drone %1 must publish").arg(i)));
+        }
+        QVERIFY(!filter.passes(7));
+    }
+
+    void test_reference_is_last_published_row() {
+        FleetState fleet = makeFleet(1);
+        PublicationFilter filter;
+        filter.resize(fleet.size());
+        tick(filter, fleet, 0);
+
+        // slow drift: each step is under the deadband, the sum is not
+        int published = 0;
+        for (int t = 1; t <= 10; ++t) {
+            fleet.altitude[0] += 0.25;
+            published += tick(filter, fleet, t * 100);
+        }
+        QCOMPARE(published, 5);
+    }
+
+    void test_paused_drones_never_publish() {
+        FleetState fleet = makeFleet(10);
+        PublicationFilter filter;
+        filter.resize(fleet.size());
+        fleet.paused[3] = 1;
+
+        QCOMPARE(tick(filter, fleet, 0), 9);
+        QVERIFY(!filter.passes(3));
+        QCOMPARE(filter.evaluated(), 9ull);
+
+        fleet.paused[3] = 0;
+        filter.invalidate(3);
+        QCOMPARE(tick(filter, fleet, 100), 1);
+        QVERIFY(filter.passes(3));
+    }
+
+    void test_link_lost_drones_are_not_counted() {
+        FleetState fleet = makeFleet(10);
+        PublicationFilter filter;
+        filter.resize(fleet.size());
+        std::vector<std::uint8_t> linkLost(fleet.size(), 0);
+        linkLost[2] = linkLost[7] = 1;
+
+        QCOMPARE(filter.evaluate(fleet, 0, linkLost.data()), 8);
+        QVERIFY(!filter.passes(2));
+        QCOMPARE(filter.evaluated(), 8ull);
+        QCOMPARE(filter.suppressed(), 0ull);
+
+        // back online: never published, so the first record goes out
+        linkLost[2] = 0;
+        QCOMPARE(filter.evaluate(fleet, 100, linkLost.data()), 9);
+        QVERIFY(filter.passes(2));
+    }
+
+    void test_restored_link_publishes_at_once() {
+        FleetState fleet = makeFleet(1);
+        PublicationFilter filter;
+        filter.resize(fleet.size());
+        std::vector<std::uint8_t> linkLost(fleet.size(), 0);
+        QCOMPARE(filter.evaluate(fleet, 0, linkLost.data()), 1);
+        filter.markPublished(fleet, 0, 0);
+
+        // lost and restored well within the heartbeat, without moving
+        linkLost[0] = 1;
+        QCOMPARE(filter.evaluate(fleet, 100, linkLost.data()), 0);
+        linkLost[0] = 0;
+        QCOMPARE(filter.evaluate(fleet, 200, linkLost.data()), 1);
+        filter.markPublished(fleet, 0, 200);
+        QCOMPARE(filter.evaluate(fleet, 300, linkLost.data()), 0);
+    }
+
+    void test_published_values_are_compared() {
+        FleetState fleet = makeFleet(2);
+        PublicationFilter filter;
+        filter.resize(fleet.size());
+        std::vector<TelemetrySnapshot> published = {fleet.snapshot(0), fleet.snapshot(1)};
+        auto publish = [&](qint64 nowMs) {
+            const int passing = filter.evaluate(fleet, nowMs, nullptr, published.data());
+            for (int i = 0; i < fleet.size(); ++i) {
+                if (filter.passes(i)) {
+                    filter.markPublished(fleet, i, nowMs, &published[i]);
+                }
+            }
+            return passing;
+        };
+        QCOMPARE(publish(0), 2);
+
+        // the true state stands still; an altimeter bias and a 3 m noise jump still reach receivers
+        published[0].altitude += 2.0;
+        published[1].latitude += 3.0 / fleet.regions[fleet.region[1]].metersPerDegreeLatitude();
+        QCOMPARE(publish(100), 2);
+
+        // and become the new reference
+        QCOMPARE(publish(200), 0);
+    }
+
+    void test_pass_through_publishes_every_tick() {
+        FleetState fleet = makeFleet(50);
+        PublicationFilter filter;
+        filter.setConfig(DeadbandConfig::passThrough());
+        filter.resize(fleet.size());
+
+        for (int t = 0; t < 5; ++t) {
+            QCOMPARE(tick(filter, fleet, t * 500), 50);
+        }
+        QCOMPARE(filter.suppressionRatio(), 0.0);
+    }
+};
+
+QTEST_MAIN(TestPublicationFilter)
+#include "test_publicationfilter.moc"
@@ -0,0 +1,203 @@
+#include <QtTest>
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "../TelemetryBusWriter.h"
+#include "../TelemetryBusReader.h"
+
+class TestTelemetryBus : public QObject {
+    Q_OBJECT
+
+private:
+    // unique per process so parallel test runs do not collide
+    static std::string busName(const char *suffix) {
+        return "/drone-telemetry-test-" + std::to_string(getpid()) + "-" + suffix;
+    }
+
+    static TelemetrySnapshot row(double value) {
+        TelemetrySnapshot snap;
+        snap.latitude = value;
+        snap.longitude = value;
+        snap.altitude = value;
+        snap.heading = value;
+        snap.speed = value;
+        snap.battery = int(value);
+        snap.timestampMs = qint64(value);
+        snap.gpsFix = TelemetrySnapshot::GpsFix::Fix2D;
+        return snap;
+    }
+
+private slots:
+
+    void test_round_trip() {
+        const std::string name = busName("rt");
+        TelemetryBusWriter writer;
+        QString error;
+        QVERIFY2(writer.open(QString::fromUtf8(name.c_str()), 3, &error), qPrintable(error));
+        writer.setId(0, "D-0000");
+        writer.setId(1, "D-0001");
+        writer.setId(2, "A-VERY-LONG-DRONE-IDENTIFIER");
+
+        TelemetryBusReader reader;
+        std::string readerError;
+        QVERIFY2(reader.open(name, &readerError), readerError.c_str());
+        QCOMPARE(reader.capacity(), 3u);
+
+        TelemetryBusReader::Frame frame;
+        QVERIFY2(!reader.read(frame), "Nothing is readable before the first commit");
+
+        writer.beginFrame(3, 1000);
+        writer.write(0, row(10.0));
+        writer.markStale(1, TelemetryBus::LinkLost);
+        writer.write(2, row(30.0));
+        writer.commitFrame();
+
+        QVERIFY(reader.read(frame));
+        QCOMPARE(frame.frame, 1ull);
+        QCOMPARE(frame.timestampMs, 1000ll);
+        QCOMPARE(frame.count, 3u);
+        QCOMPARE(frame.latitude[0], 10.0);
+        QCOMPARE(frame.battery[2], 30);
+        QCOMPARE(frame.gpsFix[0], std::uint8_t(TelemetrySnapshot::GpsFix::Fix2D));
+        QCOMPARE(frame.flags[0], std::uint8_t(TelemetryBus::Live));
+        QCOMPARE(frame.flags[1], std::uint8_t(TelemetryBus::LinkLost));
+        QVERIFY(reader.id(1) == "D-0001");
+        QVERIFY2(reader.id(2).size() == TelemetryBus::ID_BYTES - 1, "Long ids are truncated, not overflowed");
+    }
+
+    void test_reader_follows_latest_frame() {
+        const std::string name = busName("latest");
+        TelemetryBusWriter writer;
+        QVERIFY(writer.open(QString::fromUtf8(name.c_str()), 1));
+
+        TelemetryBusReader reader;
+        QVERIFY(reader.open(name));
+
+        for (int f = 1; f <= 5; ++f) {
+            writer.beginFrame(1, f);
+            writer.write(0, row(f));
+            writer.commitFrame();
+        }
+
+        TelemetryBusReader::FrameView view;
+        QVERIFY(reader.acquire(view));
+        QCOMPARE(view.frame, 5ull);
+        QCOMPARE(view.latitude[0], 5.0);
+        QVERIFY(reader.validate(view));
+
+        // two more commits reuse the view's buffer: the view must report it
+        for (int f = 6; f <= 7; ++f) {
+            writer.beginFrame(1, f);
+            writer.write(0, row(f));
+            writer.commitFrame();
+        }
+        QVERIFY2(!reader.validate(view), "A lapped view must fail validation");
+    }
+
+    void test_concurrent_reader_sees_consistent_frames() {
+        const std::string name = busName("race");
+        const int rows = 256;
+        TelemetryBusWriter writer;
+        QVERIFY(writer.open(QString::fromUtf8(name.c_str()), rows));
+
+        TelemetryBusReader reader;
+        QVERIFY(reader.open(name));
+
+        // every value of frame f equals f, so any mix of two frames is detectable
+        std::atomic<bool> done{false};
+        std::thread producer([&] {
+            for (int f = 1; f <= 20000; ++f) {
+                writer.beginFrame(rows, f);
+                for (int i = 0; i < rows; ++i) {
+                    writer.write(i, row(f));
+                }
+                writer.commitFrame();
+            }
+            done = true;
+        });
+
+        TelemetryBusReader::Frame frame;
+        int consistent = 0, torn = 0;
+        std::uint64_t last = 0;
+        bool monotonic = true;
+        while (!done) {
+            if (!reader.read(frame)) {
+                continue;
+            }
+            monotonic = monotonic && frame.frame >= last;
+            last = frame.frame;
+            bool same = true;
+            for (int i = 0; i < rows; ++i) {
+                same = same && frame.latitude[i] == double(frame.frame) && frame.battery[i] == int(frame.frame);
+            }
+            (same ? consistent : torn)++;
+        }
+        producer.join();
+
+        QVERIFY2(torn == 0, "read() must never return a mix of two frames");
+        QVERIFY2(monotonic, "Frame numbers never go backwards");
+        QVERIFY(consistent > 0);
+    }
+
+    void test_second_writer_is_refused() {
+        const std::string name = busName("busy");
+        TelemetryBusWriter first;
+        QVERIFY(first.open(QString::fromUtf8(name.c_str()), 1));
+        first.beginFrame(1, 10);
+        first.write(0, row(7.0));
+        first.commitFrame();
+
+        TelemetryBusWriter second;
+        QString error;
+        QVERIFY(!second.open(QString::fromUtf8(name.c_str()), 1, &error));
+        QVERIFY(error.contains(QString::number(getpid())));
+
+        // the first writer's region is untouched
+        TelemetryBusReader reader;
+        QVERIFY(reader.open(name));
+        TelemetryBusReader::Frame frame;
+        QVERIFY(reader.read(frame));
+        QCOMPARE(frame.frame, 1ull);
+        QCOMPARE(frame.latitude[0], 7.0);
+
+        // replacing on request; closing the replaced writer leaves the new region in place
+        QVERIFY2(second.open(QString::fromUtf8(name.c_str()), 1, &error, true), qPrintable(error));
+        first.close();
+        TelemetryBusReader after;
+        QVERIFY(after.open(name));
+    }
+
+    void test_region_of_exited_writer_is_replaced() {
+        const std::string name = busName("stale");
+
+        // the child exits without closing, as a crashed simulator would
+        const pid_t child = fork();
+        if (child == 0) {
+            TelemetryBusWriter writer;
+            _exit(writer.open(QString::fromUtf8(name.c_str()), 1) ? 0 : 1);
+        }
+        int status = 0;
+        QCOMPARE(waitpid(child, &status, 0), child);
+        QVERIFY(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+        TelemetryBusWriter writer;
+        QString error;
+        QVERIFY2(writer.open(QString::fromUtf8(name.c_str()), 1, &error), qPrintable(error));
+    }
+
+    void test_open_missing_region_fails() {
+        TelemetryBusReader reader;
+        std::string error;
+        QVERIFY(!reader.open(busName("missing"), &error));
+        QVERIFY(!error.empty());
+        QVERIFY(!reader.isOpen());
+    }
+};
+
+QTEST_MAIN(TestTelemetryBus)
+#include "test_telemetrybus.moc"
@@ -0,0 +1,122 @@
+#include <QtTest>
+#include <QDir>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+#include "../Tracing.h"
+
+class TestTracing : public QObject {
+    Q_OBJECT
+
+private slots:
+
+    void init() {
+        Tracing::setEnabled(false);
+        Tracing::clear();
+    }
+
+    void test_disabled_records_nothing() {
+        for (int i = 0; i < 100; ++i) {
+            TraceScope scope("tick", "simulator");
+        }
+        Tracing::counter("queue", 3.0);
+        QCOMPARE(Tracing::eventsRecorded(), 0LL);
+
+        // a scope that began while tracing was off is not recorded when it ends
+        {
+            TraceScope scope("tick", "simulator");
+            Tracing::setEnabled(true);
+        }
+        QCOMPARE(Tracing::eventsRecorded(), 0LL);
+    }
+
+    void test_threads_record_into_own_buffers() {
+        Tracing::setEnabled(true);
+
+        auto work = [](const char *name, int events) {
+            Tracing::setThreadName(name);
+            for (int i = 0; i < events; ++i) {
+                TraceScope scope("stepBatch", "simulator", "drones", i);
+            }
+        };
+        std::thread a(work, "worker-a", 300);
+        std::thread b(work, "worker-b", 500);
+        a.join();
+        b.join();
+
+        // buffers outlive their threads
+        QCOMPARE(Tracing::eventsRecorded(), 800LL);
+        QCOMPARE(Tracing::eventsDropped(), 0LL);
+    }
+
+    void test_full_buffer_drops_and_clear_forgets() {
+        Tracing::setEnabled(true);
+        for (int i = 0; i < Tracing::EventsPerThread + 25; ++i) {
+            Tracing::counter("value", i);
+        }
+        QCOMPARE(Tracing::eventsRecorded(), (long long)Tracing::EventsPerThread);
+        QCOMPARE(Tracing::eventsDropped(), 25LL);
+
+        // the buffer empties itself at the thread's next event
+        Tracing::clear();
+        QCOMPARE(Tracing::eventsRecorded(), 0LL);
+        Tracing::counter("value", 1.0);
+        QCOMPARE(Tracing::eventsRecorded(), 1LL);
+        QCOMPARE(Tracing::eventsDropped(), 0LL);
+    }
+
+    void test_export_chrome_trace() {
+        Tracing::setEnabled(true);
+        Tracing::setThreadName("ui");
+        {
+            TraceScope tick("tick", "simulator", "drones", 42);
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+        Tracing::counter("telemetry age ms", 12.5);
+        Tracing::counter("not computed", std::nan(""));
+        Tracing::setEnabled(false);
+
+        QTemporaryDir dir;
+        const QString path = dir.filePath("trace.json");
+        QString error;
+        QVERIFY2(Tracing::exportChromeTrace(path, &error), qPrintable(error));
+
+        QFile file(path);
+        QVERIFY(file.open(QIODevice::ReadOnly));
+        QJsonParseError parseError;
+        const QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &parseError);
+        QCOMPARE(parseError.error, QJsonParseError::NoError);
+
+        const QJsonArray events = doc.object().value("traceEvents").toArray();
+        QCOMPARE(events.size(), 4); // thread name, one scope, two counter samples
+
+        QCOMPARE(events[0].toObject().value("ph").toString(), QString("M"));
+        QCOMPARE(events[0].toObject().value("args").toObject().value("name").toString(), QString("ui"));
+
+        const QJsonObject tick = events[1].toObject();
+        QCOMPARE(tick.value("ph").toString(), QString("X"));
+        QCOMPARE(tick.value("cat").toString(), QString("simulator"));
+        QVERIFY(tick.value("dur").toDouble() >= 2000.0); // microseconds
+        QCOMPARE(tick.value("args").toObject().value("drones").toInt(), 42);
+
+        QCOMPARE(events[2].toObject().value("ph").toString(), QString("C"));
+        QCOMPARE(events[2].toObject().value("args").toObject().value("value").toDouble(), 12.5);
+        QVERIFY(events[2].toObject().value("ts").toDouble() > tick.value("ts").toDouble());
+    }
+
+    void test_export_reports_bad_path() {
+        QString error;
+        QVERIFY(!Tracing::exportChromeTrace(QDir::temp().filePath("no-such-dir/trace.json"), &error));
+        QVERIFY(!error.isEmpty());
+    }
+};
+
+QTEST_MAIN(TestTracing)
+#include "test_tracing.moc"
@@ -0,0 +1,206 @@
+#include <QtTest>
+
+#include <chrono>
+#include <cmath>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "../UdpPublisher.h"
+#include "../TelemetryWire.h"
+
+// UDP socket bound to an ephemeral loopback port, standing in for an ingest service.
+class LoopbackReceiver {
+public:
+    LoopbackReceiver() {
+        m_fd = socket(AF_INET, SOCK_DGRAM, 0);
+        int buffer = 16 << 20;
+        setsockopt(m_fd, SOL_SOCKET, SO_RCVBUF, &buffer, sizeof(buffer));
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;
+        bind(m_fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr));
+        socklen_t length = sizeof(addr);
+        getsockname(m_fd, reinterpret_cast<sockaddr *>(&addr), &length);
+        m_port = ntohs(addr.sin_port);
+    }
+
+    ~LoopbackReceiver() { ::close(m_fd); }
+
+    quint16 port() const { return m_port; }
+
+    // Receives datagrams until none arrives for idleMs.
+    std::vector<std::vector<unsigned char>> drain(int idleMs = 300) {
+        std::vector<std::vector<unsigned char>> datagrams;
+        unsigned char buffer[65536];
+        pollfd p{m_fd, POLLIN, 0};
+        while (poll(&p, 1, idleMs) > 0) {
+            const ssize_t n = recv(m_fd, buffer, sizeof(buffer), 0);
+            if (n > 0) {
+                datagrams.emplace_back(buffer, buffer + n);
+            }
+        }
+        return datagrams;
+    }
+
+private:
+    int m_fd = -1;
+    quint16 m_port = 0;
+};
+
+class TestUdpPublisher : public QObject {
+    Q_OBJECT
+
+private:
+    static TelemetrySnapshot sample(int drone, int tick) {
+        TelemetrySnapshot snap;
+        snap.latitude = 28.6 + drone * 1e-4 + tick * 1e-6;
+        snap.longitude = 77.2 - drone * 1e-4;
+        snap.altitude = 50.0 + drone * 0.001;
+        snap.heading = std::fmod(drone * 7.31, 360.0);
+        snap.speed = 8.25;
+        snap.battery = 100 - tick;
+        snap.gpsFix = TelemetrySnapshot::GpsFix::Fix3D;
+        snap.timestampMs = 1000 * tick;
+        return snap;
+    }
+
+private slots:
+
+    void test_wire_round_trip() {
+        unsigned char datagram[TelemetryWire::MAX_DATAGRAM_BYTES];
+        TelemetryWire::Header h;
+        h.count = 1;
+        h.sequence = 0xA1B2C3D4u;
+        h.tick = 7;
+        TelemetryWire::writeHeader(datagram, h);
+
+        TelemetryWire::Record r;
+        r.drone = 123456;
+        r.timestampMs = -5;
+        r.latitudeE7 = -337000000;
+        r.longitudeE7 = 1512000000;
+        r.altitudeMm = -1200;
+        r.headingCdeg = 35999;
+        r.speedCms = 65535;
+        r.battery = 42;
+        r.gpsFix = 2;
+        TelemetryWire::writeRecord(datagram + TelemetryWire::HEADER_BYTES, r);
+
+        TelemetryWire::Header back;
+        QVERIFY(TelemetryWire::readHeader(datagram, TelemetryWire::HEADER_BYTES + TelemetryWire::RECORD_BYTES, back));
+        QVERIFY(!TelemetryWire::readHeader(datagram, TelemetryWire::HEADER_BYTES + 8, back));
+        QCOMPARE(back.sequence, 0xA1B2C3D4u);
+        QCOMPARE(back.tick, 7u);
+
+        const TelemetryWire::Record out = TelemetryWire::readRecord(datagram, 0);
+        QCOMPARE(out.drone, r.drone);
+        QCOMPARE(out.timestampMs, r.timestampMs);
+        QCOMPARE(out.latitudeE7, r.latitudeE7);
+        QCOMPARE(out.longitudeE7, r.longitudeE7);
+        QCOMPARE(out.altitudeMm, r.altitudeMm);
+        QCOMPARE(out.headingCdeg, r.headingCdeg);
+        QCOMPARE(out.speedCms, r.speedCms);
+        QCOMPARE(out.battery, r.battery);
+        QCOMPARE(out.gpsFix, r.gpsFix);
+    }
+
+    void test_loopback_delivers_every_record() {
+        LoopbackReceiver receiver;
+        UdpPublisher publisher;
+        QString error;
+        QVERIFY2(publisher.open("127.0.0.1", receiver.port(), 8192, &error), qPrintable(error));
+
+        const int drones = 2000;
+        const int ticks = 5;
+        for (int i = 0; i < drones; ++i) {
+            publisher.setId(i, QString("D-%1").arg(i, 4, 10, QChar('0')));
+        }
+        for (int t = 1; t <= ticks; ++t) {
+            publisher.beginTick(1000 * t);
+            for (int i = 0; i < drones; ++i) {
+                publisher.add(i, sample(i, t));
+            }
+            publisher.endTick();
+        }
+
+        const std::vector<std::vector<unsigned char>> datagrams = receiver.drain();
+        publisher.close();
+
+        std::map<std::pair<int, int>, TelemetryWire::Record> records;
+        int ids = 0;
+        std::uint32_t expectedSequence = 0;
+        bool inOrder = true;
+        for (const std::vector<unsigned char> &d : datagrams) {
+            QVERIFY2(d.size() <= TelemetryWire::MAX_DATAGRAM_BYTES, "GSO buffers must arrive as MTU-sized datagrams");
+            TelemetryWire::Header h;
+            QVERIFY(TelemetryWire::readHeader(d.data(), d.size(), h));
+            inOrder = inOrder && h.sequence == expectedSequence++;
+            for (int k = 0; k < h.count; ++k) {
+                if (h.kind == TelemetryWire::Kind::Ids) {
+                    ++ids;
+                } else {
+                    const TelemetryWire::Record r = TelemetryWire::readRecord(d.data(), k);
+                    records[{int(h.tick), int(r.drone)}] = r;
+                }
+            }
+        }
+
+        QVERIFY2(inOrder, "Datagram sequence numbers arrive without gaps on loopback");
+        QCOMPARE(ids, drones);
+        QCOMPARE(int(records.size()), drones * ticks);
+        QCOMPARE(publisher.recordsQueued(), std::uint64_t(drones * ticks));
+        QCOMPARE(publisher.recordsDropped(), std::uint64_t(0));
+
+        const int records45 = int(TelemetryWire::RECORDS_PER_DATAGRAM);
+        QVERIFY2(publisher.sendCalls() < publisher.datagramsSent(), "Datagrams are batched into fewer system calls");
+        QVERIFY(int(datagrams.size()) >= ticks * ((drones + records45 - 1) / records45));
+
+        const TelemetryWire::Record &r = records[{3, 1234}];
+        const TelemetrySnapshot expected = sample(1234, 3);
+        QVERIFY(std::fabs(r.latitudeE7 * 1e-7 - expected.latitude) < 1e-7);
+        QVERIFY(std::fabs(r.longitudeE7 * 1e-7 - expected.longitude) < 1e-7);
+        QVERIFY(std::fabs(r.altitudeMm * 1e-3 - expected.altitude) < 1e-3);
+        QVERIFY(std::fabs(r.headingCdeg * 0.01 - expected.heading) < 0.01);
+        QCOMPARE(int(r.speedCms), 825);
+        QCOMPARE(int(r.battery), expected.battery);
+        QCOMPARE(r.timestampMs, expected.timestampMs);
+    }
+
+    void test_full_ring_drops_instead_of_blocking() {
+        LoopbackReceiver receiver;
+        UdpPublisher publisher;
+        QVERIFY(publisher.open("127.0.0.1", receiver.port(), 2));
+
+        // 2 slots hold 90 records: a 100k-record burst must return immediately, dropping the rest
+        const auto start = std::chrono::steady_clock::now();
+        publisher.beginTick(1);
+        for (int i = 0; i < 100000; ++i) {
+            publisher.add(i, sample(i, 1));
+        }
+        publisher.endTick();
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+
+        QVERIFY(publisher.recordsDropped() > 0);
+        QVERIFY(publisher.recordsQueued() + publisher.recordsDropped() == 100000);
+        QVERIFY(elapsed < std::chrono::milliseconds(500));
+        publisher.close();
+    }
+
+    void test_unresolvable_host_fails() {
+        UdpPublisher publisher;
+        QString error;
+        QVERIFY(!publisher.open("no-such-host.invalid", 9, 16, &error));
+        QVERIFY(!publisher.isOpen());
+    }
+};
+
+QTEST_MAIN(TestUdpPublisher)
+#include "test_udppublisher.moc"
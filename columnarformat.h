@@ -0,0 +1,193 @@
+/******************************************************************************
+ * ColumnarFormat.h
+ * Author: Jatin Kumawat
+ * Date: 19-10-2026
+ *
+ * Description:
+ *   Self-describing chunked columnar file format of telemetry recordings.
+ *
+ *   File:    MAGIC | row group 0 | row group 1 | ... | footer | u32 footer bytes | MAGIC
+ *   Row group: one chunk per column, fixed number of rows (the last may be shorter)
+ *   Chunk:   delta + zigzag + LEB128 varint encoded integers
+ *   Footer:  column names, scales and encodings, the drone id dictionary,
+ *            and per row group and column: offset, size, min and max
+ *
+ *   - Every value is an integer (scaled like TelemetryWire.h: 1e-7 deg, mm,
+ *  cm/s, centidegrees), so slowly changing columns shrink to a byte or two
+ *   - min/max per chunk let readers skip row groups that cannot match a
+ *  predicate without decoding them
+ *   - Little-endian, header-only, no Qt: analytics tools can include it as is
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace ColumnarFormat
+{
+    constexpr char MAGIC[8] = {'D', 'T', 'C', 'O', 'L', '0', '1', '\0'};
+    constexpr std::uint32_t VERSION = 1;
+
+    enum class Encoding : std::uint8_t
+    {
+        DeltaVarint = 1 // First value and successive differences, zigzag + LEB128.
+    };
+
+    // Columns written by the recorder, in file order. Readers should look columns up by name.
+    enum Column
+    {
+        Drone,       // Drone index (see the id dictionary).
+        TimestampMs, // ms since epoch.
+        Latitude,    // Degrees * 1e7.
+        Longitude,   // Degrees * 1e7.
+        Altitude,    // Millimeters.
+        Speed,       // cm/s.
+        Heading,     // Centidegrees.
+        Battery,     // Percent.
+        GpsFix,      // TelemetrySnapshot::GpsFix.
+        COLUMN_COUNT
+    };
+
+    struct ColumnInfo
+    {
+        const char *name;
+        double scale; // Physical value = stored integer * scale.
+    };
+
+    constexpr ColumnInfo COLUMNS[COLUMN_COUNT] = {
+        {"drone", 1.0},
+        {"timestamp_ms", 1.0},
+        {"latitude", 1e-7},
+        {"longitude", 1e-7},
+        {"altitude", 1e-3},
+        {"speed", 1e-2},
+        {"heading", 1e-2},
+        {"battery", 1.0},
+        {"gps_fix", 1.0},
+    };
+
+    // --- little-endian scalars ---
+
+    inline void append(std::vector<unsigned char> &out, const void *p, std::size_t bytes)
+    {
+        const unsigned char *b = static_cast<const unsigned char *>(p);
+        out.insert(out.end(), b, b + bytes);
+    }
+
+    template <typename T>
+    inline void appendLE(std::vector<unsigned char> &out, T value)
+    {
+        for (std::size_t k = 0; k < sizeof(T); ++k)
+            out.push_back(std::uint8_t(std::uint64_t(value) >> (8 * k)));
+    }
+
+    template <>
+    inline void appendLE<double>(std::vector<unsigned char> &out, double value)
+    {
+        std::uint64_t bits;
+        std::memcpy(&bits, &value, 8);
+        appendLE<std::uint64_t>(out, bits);
+    }
+
+    inline void appendString(std::vector<unsigned char> &out, const std::string &s)
+    {
+        appendLE<std::uint16_t>(out, std::uint16_t(s.size() < 0xFFFF ? s.size() : 0xFFFF));
+        append(out, s.data(), s.size() < 0xFFFF ? s.size() : 0xFFFF);
+    }
+
+    // Bounds-checked cursor over a byte range (footer parsing).
+    struct Cursor
+    {
+        const unsigned char *p;
+        const unsigned char *end;
+        bool ok = true;
+
+        template <typename T>
+        T read()
+        {
+            if (std::size_t(end - p) < sizeof(T))
+            {
+                ok = false;
+                return T();
+            }
+            std::uint64_t v = 0;
+            for (std::size_t k = 0; k < sizeof(T); ++k)
+                v |= std::uint64_t(p[k]) << (8 * k);
+            p += sizeof(T);
+            T out;
+            if constexpr (sizeof(T) == 8)
+                std::memcpy(&out, &v, 8);
+            else
+                out = T(v);
+            return out;
+        }
+
+        std::string readString()
+        {
+            const std::size_t n = read<std::uint16_t>();
+            if (!ok || std::size_t(end - p) < n)
+            {
+                ok = false;
+                return std::string();
+            }
+            std::string s(reinterpret_cast<const char *>(p), n);
+            p += n;
+            return s;
+        }
+    };
+
+    // --- chunk codec ---
+
+    inline std::uint64_t zigzag(std::int64_t v) { return (std::uint64_t(v) << 1) ^ std::uint64_t(v >> 63); }
+
+    inline std::int64_t unzigzag(std::uint64_t v) { return std::int64_t(v >> 1) ^ -std::int64_t(v & 1); }
+
+    // Appends values[0..count) to out; returns min and max of the chunk.
+    inline void encodeChunk(const std::int64_t *values, std::size_t count, std::vector<unsigned char> &out, std::int64_t &min, std::int64_t &max)
+    {
+        std::int64_t previous = 0;
+        min = count ? values[0] : 0;
+        max = min;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const std::int64_t v = values[i];
+            min = v < min ? v : min;
+            max = v > max ? v : max;
+            std::uint64_t z = zigzag(std::int64_t(std::uint64_t(v) - std::uint64_t(previous)));
+            previous = v;
+            while (z >= 0x80)
+            {
+                out.push_back(std::uint8_t(z | 0x80));
+                z >>= 7;
+            }
+            out.push_back(std::uint8_t(z));
+        }
+    }
+
+    // Decodes count values; returns false if the chunk is truncated or malformed.
+    inline bool decodeChunk(const unsigned char *p, std::size_t bytes, std::size_t count, std::int64_t *values)
+    {
+        const unsigned char *end = p + bytes;
+        std::int64_t previous = 0;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            std::uint64_t z = 0;
+            for (int shift = 0;; shift += 7)
+            {
+                if (p == end || shift > 63)
+                    return false;
+                const std::uint8_t b = *p++;
+                z |= std::uint64_t(b & 0x7F) << shift;
+                if (!(b & 0x80))
+                    break;
+            }
+            previous = std::int64_t(std::uint64_t(previous) + std::uint64_t(unzigzag(z)));
+            values[i] = previous;
+        }
+        return p == end;
+    }
+}
@@ -0,0 +1,262 @@
+#include "ColumnarReader.h"
+
+#include <cerrno>
+
+#include <cstring>
+
+using namespace ColumnarFormat;
+
+static bool fail(std::string *error, const std::string &message)
+{
+
+    if (error)
+        *error = message;
+
+    return false;
+}
+
+// 64-bit file offsets (recordings easily exceed 2 GiB)
+
+static bool seekTo(std::FILE *file, std::uint64_t offset)
+{
+
+#if defined(_WIN32)
+
+    return _fseeki64(file, std::int64_t(offset), SEEK_SET) == 0;
+
+#else
+
+    return fseeko(file, off_t(offset), SEEK_SET) == 0;
+
+#endif
+}
+
+static bool readAt(std::FILE *file, std::uint64_t offset, void *out, std::size_t bytes)
+{
+
+    return seekTo(file, offset) && std::fread(out, 1, bytes, file) == bytes;
+}
+
+ColumnarReader::~ColumnarReader()
+{
+
+    close();
+}
+
+bool ColumnarReader::open(const std::string &path, std::string *error)
+{
+
+    close();
+
+    std::FILE *file = std::fopen(path.c_str(), "rb");
+
+    if (!file)
+        return fail(error, "cannot open " + path + ": " + std::strerror(errno));
+
+    // trailer: u32 footer size + magic, at the very end
+
+    unsigned char head[sizeof(MAGIC)];
+
+    unsigned char tail[4 + sizeof(MAGIC)];
+
+    std::uint64_t size = 0;
+
+#if defined(_WIN32)
+
+    const bool sized = _fseeki64(file, 0, SEEK_END) == 0 && (size = std::uint64_t(_ftelli64(file))) > 0;
+
+#else
+
+    const bool sized = fseeko(file, 0, SEEK_END) == 0 && (size = std::uint64_t(ftello(file))) > 0;
+
+#endif
+
+    if (!sized || size < sizeof(head) + sizeof(tail) || !readAt(file, 0, head, sizeof(head)) || !readAt(file, size - sizeof(tail), tail, sizeof(tail)) || std::memcmp(head, MAGIC, sizeof(MAGIC)) != 0 || std::memcmp(tail + 4, MAGIC, sizeof(MAGIC)) != 0)
+    {
+
+        std::fclose(file);
+
+        return fail(error, path + " is not a finished columnar recording");
+    }
+
+    Cursor trailer{tail, tail + 4};
+
+    const std::uint32_t footerBytes = trailer.read<std::uint32_t>();
+
+    if (footerBytes > size - sizeof(head) - sizeof(tail))
+    {
+
+        std::fclose(file);
+
+        return fail(error, path + " has a corrupt footer size");
+    }
+
+    std::vector<unsigned char> footer(footerBytes);
+
+    if (!readAt(file, size - sizeof(tail) - footerBytes, footer.data(), footerBytes))
+    {
+
+        std::fclose(file);
+
+        return fail(error, "cannot read the footer of " + path);
+    }
+
+    Cursor in{footer.data(), footer.data() + footer.size()};
+
+    const std::uint32_t version = in.read<std::uint32_t>();
+
+    in.read<std::uint32_t>(); // nominal row group size, informative only
+
+    const std::uint32_t columnCount = in.read<std::uint32_t>();
+
+    if (!in.ok || version != VERSION)
+    {
+
+        std::fclose(file);
+
+        return fail(error, path + " was written by an incompatible version");
+    }
+
+    for (std::uint32_t c = 0; c < columnCount && in.ok; ++c)
+    {
+
+        ColumnMeta meta;
+
+        meta.name = in.readString();
+
+        meta.encoding = Encoding(in.read<std::uint8_t>());
+
+        meta.scale = in.read<double>();
+
+        m_columns.push_back(meta);
+    }
+
+    const std::uint32_t idCount = in.read<std::uint32_t>();
+
+    for (std::uint32_t i = 0; i < idCount && in.ok; ++i)
+        m_ids.push_back(in.readString());
+
+    const std::uint32_t groupCount = in.read<std::uint32_t>();
+
+    for (std::uint32_t g = 0; g < groupCount && in.ok; ++g)
+    {
+
+        m_rows.push_back(in.read<std::uint32_t>());
+
+        m_rowCount += m_rows.back();
+
+        for (std::uint32_t c = 0; c < columnCount; ++c)
+        {
+
+            Chunk chunk;
+
+            chunk.offset = in.read<std::uint64_t>();
+
+            chunk.bytes = in.read<std::uint32_t>();
+
+            chunk.min = in.read<std::int64_t>();
+
+            chunk.max = in.read<std::int64_t>();
+
+            in.ok = in.ok && chunk.offset + chunk.bytes <= size;
+
+            m_chunks.push_back(chunk);
+        }
+    }
+
+    if (!in.ok)
+    {
+
+        std::fclose(file);
+
+        close();
+
+        return fail(error, path + " has a corrupt footer");
+    }
+
+    m_file = file;
+
+    return true;
+}
+
+void ColumnarReader::close()
+{
+
+    if (m_file)
+        std::fclose(m_file);
+
+    m_file = nullptr;
+
+    m_columns.clear();
+
+    m_ids.clear();
+
+    m_rows.clear();
+
+    m_chunks.clear();
+
+    m_rowCount = 0;
+}
+
+int ColumnarReader::findColumn(const std::string &name) const
+{
+
+    for (std::size_t c = 0; c < m_columns.size(); ++c)
+    {
+
+        if (m_columns[c].name == name)
+            return int(c);
+    }
+
+    return -1;
+}
+
+bool ColumnarReader::mayContain(int g, int c, double lo, double hi) const
+{
+
+    const Chunk &k = chunk(g, c);
+
+    const double scale = m_columns[c].scale;
+
+    return k.max * scale >= lo && k.min * scale <= hi;
+}
+
+bool ColumnarReader::readColumn(int g, int c, std::vector<std::int64_t> &values, std::string *error)
+{
+
+    if (!m_file || g < 0 || g >= rowGroupCount() || c < 0 || c >= columnCount())
+        return fail(error, "no such row group or column");
+
+    if (m_columns[c].encoding != Encoding::DeltaVarint)
+        return fail(error, "unsupported encoding of column " + m_columns[c].name);
+
+    const Chunk &k = chunk(g, c);
+
+    m_buffer.resize(k.bytes);
+
+    if (!readAt(m_file, k.offset, m_buffer.data(), k.bytes))
+        return fail(error, "cannot read column " + m_columns[c].name);
+
+    values.resize(m_rows[g]);
+
+    if (!decodeChunk(m_buffer.data(), k.bytes, values.size(), values.data()))
+        return fail(error, "corrupt chunk in column " + m_columns[c].name);
+
+    return true;
+}
+
+bool ColumnarReader::readColumn(int g, int c, std::vector<double> &values, std::string *error)
+{
+
+    if (!readColumn(g, c, m_integers, error))
+        return false;
+
+    const double scale = m_columns[c].scale;
+
+    values.resize(m_integers.size());
+
+    for (std::size_t k = 0; k < m_integers.size(); ++k)
+        values[k] = double(m_integers[k]) * scale;
+
+    return true;
+}
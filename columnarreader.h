@@ -0,0 +1,91 @@
+/******************************************************************************
+ * ColumnarReader.h
+ * Author: Jatin Kumawat
+ * Date: 19-10-2026
+ *
+ * Description:
+ *   Reader of columnar telemetry recordings (format in ColumnarFormat.h).
+ *
+ *   - open() reads only the footer: schema, id dictionary and per-chunk
+ *  min/max of every row group
+ *   - mayContain() answers range predicates from the statistics alone, so a
+ *  scan decodes only the row groups that can match (predicate pushdown)
+ *   - readColumn() decodes one column of one row group, nothing else
+ *   - No Qt dependency: built as the small ColumnarReader library
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "ColumnarFormat.h"
+
+class ColumnarReader
+{
+public:
+    struct ColumnMeta
+    {
+        std::string name;
+        ColumnarFormat::Encoding encoding = ColumnarFormat::Encoding::DeltaVarint;
+        double scale = 1.0; // Physical value = stored integer * scale.
+    };
+
+    struct Chunk
+    {
+        std::uint64_t offset = 0;
+        std::uint32_t bytes = 0;
+        std::int64_t min = 0; // Stored integers.
+        std::int64_t max = 0;
+    };
+
+    ColumnarReader() = default;
+
+    ~ColumnarReader(); // Closes the file.
+
+    ColumnarReader(const ColumnarReader &) = delete;
+    ColumnarReader &operator=(const ColumnarReader &) = delete;
+
+    // Opens a finished recording and reads its footer. On failure returns false and describes the reason in error (if given).
+    bool open(const std::string &path, std::string *error = nullptr);
+
+    void close(); // Closes the file.
+
+    bool isOpen() const { return m_file != nullptr; } // True between a successful open() and close().
+
+    int columnCount() const { return int(m_columns.size()); }
+
+    const ColumnMeta &column(int c) const { return m_columns[c]; }
+
+    int findColumn(const std::string &name) const; // Column index, or -1.
+
+    int rowGroupCount() const { return int(m_rows.size()); }
+
+    std::uint32_t rowGroupRows(int g) const { return m_rows[g]; } // Rows in row group g.
+
+    std::uint64_t rowCount() const { return m_rowCount; } // Rows in the file.
+
+    const Chunk &chunk(int g, int c) const { return m_chunks[std::size_t(g) * m_columns.size() + c]; }
+
+    // False if no value of column c in row group g can lie in [lo, hi] (physical units), from the statistics only.
+    bool mayContain(int g, int c, double lo, double hi) const;
+
+    // Decodes column c of row group g as stored integers. Reuses values' storage.
+    bool readColumn(int g, int c, std::vector<std::int64_t> &values, std::string *error = nullptr);
+
+    // Decodes column c of row group g in physical units. Reuses values' storage.
+    bool readColumn(int g, int c, std::vector<double> &values, std::string *error = nullptr);
+
+    const std::vector<std::string> &ids() const { return m_ids; } // Drone ids by drone index.
+
+private:
+    std::FILE *m_file = nullptr;
+    std::vector<ColumnMeta> m_columns;
+    std::vector<std::string> m_ids;
+    std::vector<std::uint32_t> m_rows; // Rows per row group.
+    std::vector<Chunk> m_chunks;       // Row-group-major.
+    std::uint64_t m_rowCount = 0;
+    std::vector<unsigned char> m_buffer;     // Scratch: one encoded chunk.
+    std::vector<std::int64_t> m_integers;    // Scratch: decoded integers.
+};
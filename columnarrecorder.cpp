@@ -0,0 +1,392 @@
+#include "ColumnarRecorder.h"
+
+#include <algorithm>
+
+#include <cerrno>
+
+#include <cstring>
+
+#include "TelemetryWire.h"
+
+using namespace ColumnarFormat;
+
+static bool fail(QString *error, const QString &message)
+{
+
+    if (error)
+        *error = message;
+
+    return false;
+}
+
+ColumnarRecorder::~ColumnarRecorder()
+{
+
+    close();
+}
+
+bool ColumnarRecorder::open(const QString &path, std::uint32_t rowGroupRows, int buffers, QString *error)
+{
+
+    close();
+
+    if (rowGroupRows == 0 || buffers < 1)
+        return fail(error, QString("invalid row group size or buffer count"));
+
+    const QByteArray fileName = path.toUtf8();
+
+    std::FILE *file = std::fopen(fileName.constData(), "wb");
+
+    if (!file)
+        return fail(error, QString("cannot create %1: %2").arg(path).arg(QString(std::strerror(errno))));
+
+    if (std::fwrite(MAGIC, 1, sizeof(MAGIC), file) != sizeof(MAGIC))
+    {
+
+        std::fclose(file);
+
+        return fail(error, QString("cannot write %1").arg(path));
+    }
+
+    m_rowGroupRows = rowGroupRows;
+
+    m_offset = sizeof(MAGIC);
+
+    m_writeFailed = false;
+
+    // every buffer is sized once here; the tick never grows a column
+
+    m_groups.clear();
+
+    m_free.clear();
+
+    m_full.clear();
+
+    m_full.reserve(buffers);
+
+    m_free.reserve(buffers);
+
+    for (int b = 0; b < buffers; ++b)
+    {
+
+        std::unique_ptr<RowGroup> group = std::make_unique<RowGroup>();
+
+        for (std::vector<std::int64_t> &column : group->columns)
+            column.resize(rowGroupRows);
+
+        m_free.push_back(group.get());
+
+        m_groups.push_back(std::move(group));
+    }
+
+    m_freeCount.store(buffers, std::memory_order_relaxed);
+
+    m_current = nullptr;
+
+    m_sorted.resize(rowGroupRows);
+
+    m_order.resize(rowGroupRows);
+
+    m_meta.clear();
+
+    m_stopping = false;
+
+    m_file = file;
+
+    m_writer = std::thread(&ColumnarRecorder::writerLoop, this);
+
+    return true;
+}
+
+void ColumnarRecorder::close()
+{
+
+    if (!m_file)
+        return;
+
+    if (m_current && m_current->rows > 0)
+        submit();
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_stopping = true;
+    }
+
+    m_wake.notify_one();
+
+    if (m_writer.joinable())
+        m_writer.join();
+
+    writeFooter();
+
+    std::fclose(m_file);
+
+    m_file = nullptr;
+
+    m_current = nullptr;
+
+    m_free.clear();
+
+    m_groups.clear();
+}
+
+void ColumnarRecorder::setId(int i, const QString &id)
+{
+
+    if (i < 0)
+        return;
+
+    if (i >= int(m_ids.size()))
+        m_ids.resize(i + 1);
+
+    m_ids[i] = id.toStdString();
+}
+
+ColumnarRecorder::RowGroup *ColumnarRecorder::takeFree()
+{
+
+    // cheap check first: while the writer holds every buffer the tick does not touch the mutex
+
+    if (m_freeCount.load(std::memory_order_acquire) == 0)
+        return nullptr;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_free.empty())
+        return nullptr;
+
+    RowGroup *group = m_free.back();
+
+    m_free.pop_back();
+
+    m_freeCount.fetch_sub(1, std::memory_order_relaxed);
+
+    return group;
+}
+
+void ColumnarRecorder::submit()
+{
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_full.push_back(m_current);
+    }
+
+    m_wake.notify_one();
+
+    m_current = nullptr;
+}
+
+void ColumnarRecorder::record(int i, const TelemetrySnapshot &snap)
+{
+
+    if (!m_file)
+        return;
+
+    if (!m_current && !(m_current = takeFree()))
+    {
+
+        m_rowsDropped.fetch_add(1, std::memory_order_relaxed);
+
+        return;
+    }
+
+    RowGroup &g = *m_current;
+
+    const std::uint32_t r = g.rows++;
+
+    // same integer scaling as the UDP wire format
+
+    g.columns[Drone][r] = i;
+
+    g.columns[TimestampMs][r] = snap.timestampMs;
+
+    g.columns[Latitude][r] = TelemetryWire::quantize<std::int32_t>(snap.latitude, 1e7, -900000000.0, 900000000.0);
+
+    g.columns[Longitude][r] = TelemetryWire::quantize<std::int32_t>(snap.longitude, 1e7, -1800000000.0, 1800000000.0);
+
+    g.columns[Altitude][r] = TelemetryWire::quantize<std::int32_t>(snap.altitude, 1e3, -2147483648.0, 2147483647.0);
+
+    g.columns[Speed][r] = TelemetryWire::quantize<std::int32_t>(snap.speed, 100.0, 0.0, 2147483647.0);
+
+    g.columns[Heading][r] = TelemetryWire::quantize<std::int32_t>(snap.heading, 100.0, 0.0, 35999.0);
+
+    g.columns[Battery][r] = snap.battery;
+
+    g.columns[GpsFix][r] = int(snap.gpsFix);
+
+    if (g.rows == m_rowGroupRows)
+        submit();
+}
+
+void ColumnarRecorder::writerLoop()
+{
+
+    for (;;)
+    {
+
+        RowGroup *group = nullptr;
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            m_wake.wait(lock, [this] { return !m_full.empty() || m_stopping; });
+
+            // stop only once everything queued before close() is written
+
+            if (m_full.empty())
+                return;
+
+            group = m_full.front();
+
+            m_full.erase(m_full.begin());
+        }
+
+        writeRowGroup(*group);
+
+        group->rows = 0;
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            m_free.push_back(group);
+
+            m_freeCount.fetch_add(1, std::memory_order_release);
+        }
+    }
+}
+
+void ColumnarRecorder::writeRowGroup(RowGroup &group)
+{
+
+    const std::uint32_t n = group.rows;
+
+    if (m_writeFailed)
+    {
+
+        m_rowsDropped.fetch_add(n, std::memory_order_relaxed);
+
+        return;
+    }
+
+    // stable counting sort by drone: each drone's samples become one run in time order,
+    // so deltas stay small and the drone column's min/max narrows to the drones present
+
+    const std::vector<std::int64_t> &drone = group.columns[Drone];
+
+    const std::int64_t maxDrone = *std::max_element(drone.begin(), drone.begin() + n);
+
+    m_histogram.assign(std::size_t(maxDrone) + 2, 0);
+
+    for (std::uint32_t r = 0; r < n; ++r)
+        ++m_histogram[std::size_t(drone[r]) + 1];
+
+    for (std::size_t d = 1; d < m_histogram.size(); ++d)
+        m_histogram[d] += m_histogram[d - 1];
+
+    for (std::uint32_t r = 0; r < n; ++r)
+        m_order[m_histogram[std::size_t(drone[r])]++] = r;
+
+    RowGroupMeta meta;
+
+    meta.rows = n;
+
+    for (int c = 0; c < COLUMN_COUNT; ++c)
+    {
+
+        const std::vector<std::int64_t> &column = group.columns[c];
+
+        for (std::uint32_t k = 0; k < n; ++k)
+            m_sorted[k] = column[m_order[k]];
+
+        m_encoded.clear();
+
+        ChunkMeta &chunk = meta.chunks[c];
+
+        encodeChunk(m_sorted.data(), n, m_encoded, chunk.min, chunk.max);
+
+        chunk.offset = m_offset;
+
+        chunk.bytes = std::uint32_t(m_encoded.size());
+
+        if (std::fwrite(m_encoded.data(), 1, m_encoded.size(), m_file) != m_encoded.size())
+        {
+
+            // later chunks would land after a torn one: stop, the footer still describes what was written
+
+            m_writeFailed = true;
+
+            m_rowsDropped.fetch_add(n, std::memory_order_relaxed);
+
+            return;
+        }
+
+        m_offset += m_encoded.size();
+    }
+
+    m_meta.push_back(meta);
+
+    m_rowsRecorded.fetch_add(n, std::memory_order_relaxed);
+
+    m_bytesWritten.store(m_offset, std::memory_order_relaxed);
+}
+
+bool ColumnarRecorder::writeFooter()
+{
+
+    std::vector<unsigned char> footer;
+
+    appendLE<std::uint32_t>(footer, VERSION);
+
+    appendLE<std::uint32_t>(footer, m_rowGroupRows);
+
+    appendLE<std::uint32_t>(footer, COLUMN_COUNT);
+
+    for (const ColumnInfo &column : COLUMNS)
+    {
+
+        appendString(footer, column.name);
+
+        appendLE<std::uint8_t>(footer, std::uint8_t(Encoding::DeltaVarint));
+
+        appendLE<double>(footer, column.scale);
+    }
+
+    appendLE<std::uint32_t>(footer, std::uint32_t(m_ids.size()));
+
+    for (const std::string &id : m_ids)
+        appendString(footer, id);
+
+    appendLE<std::uint32_t>(footer, std::uint32_t(m_meta.size()));
+
+    for (const RowGroupMeta &meta : m_meta)
+    {
+
+        appendLE<std::uint32_t>(footer, meta.rows);
+
+        for (const ChunkMeta &chunk : meta.chunks)
+        {
+
+            appendLE<std::uint64_t>(footer, chunk.offset);
+
+            appendLE<std::uint32_t>(footer, chunk.bytes);
+
+            appendLE<std::int64_t>(footer, chunk.min);
+
+            appendLE<std::int64_t>(footer, chunk.max);
+        }
+    }
+
+    appendLE<std::uint32_t>(footer, std::uint32_t(footer.size()));
+
+    append(footer, MAGIC, sizeof(MAGIC));
+
+    const bool ok = std::fwrite(footer.data(), 1, footer.size(), m_file) == footer.size() && std::fflush(m_file) == 0;
+
+    if (ok)
+        m_bytesWritten.store(m_offset + footer.size(), std::memory_order_relaxed);
+
+    return ok;
+}
@@ -0,0 +1,130 @@
+/******************************************************************************
+ * ColumnarRecorder.h
+ * Author: Jatin Kumawat
+ * Date: 19-10-2026
+ *
+ * Description:
+ *   Records published telemetry into a chunked columnar file (format in
+ *   ColumnarFormat.h) for offline analytics.
+ *
+ *   - The tick thread only quantizes each record into the columns of a
+ *  preallocated row group buffer; no allocation, no I/O
+ *   - Full row groups are handed to a writer thread, which orders the rows
+ *  by drone (then time), encodes and compresses every column, computes
+ *  per-chunk min/max and writes them
+ *   - A fixed pool of row group buffers: if the writer falls behind, rows
+ *  are dropped (counted) instead of blocking the tick
+ ******************************************************************************/
+
+#pragma once
+
+#include <QString>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "TelemetryTypes.h"
+#include "ColumnarFormat.h"
+
+class ColumnarRecorder
+{
+public:
+    ColumnarRecorder() = default;
+
+    ~ColumnarRecorder(); // Finishes the file (see close()).
+
+    ColumnarRecorder(const ColumnarRecorder &) = delete;
+    ColumnarRecorder &operator=(const ColumnarRecorder &) = delete;
+
+    // Creates path (truncating it), allocates `buffers` row groups of rowGroupRows rows each
+    // and starts the writer thread. On failure returns false and describes the reason in error (if given).
+    bool open(const QString &path, std::uint32_t rowGroupRows = 65536, int buffers = 4, QString *error = nullptr);
+
+    // Writes the partial row group and the footer, stops the writer thread and closes the file.
+    void close();
+
+    bool isOpen() const { return m_file != nullptr; } // True between a successful open() and close().
+
+    // Remembers the id of drone i (written to the footer's id dictionary on close()).
+    void setId(int i, const QString &id);
+
+    // --- tick thread ---
+
+    void record(int i, const TelemetrySnapshot &snap); // Appends one row.
+
+    // --- statistics (any thread) ---
+
+    std::uint64_t rowsRecorded() const { return m_rowsRecorded.load(std::memory_order_relaxed); } // Rows in the file (once written).
+
+    std::uint64_t rowsDropped() const { return m_rowsDropped.load(std::memory_order_relaxed); } // No free buffer, or a write failed.
+
+    std::uint64_t bytesWritten() const { return m_bytesWritten.load(std::memory_order_relaxed); }
+
+private:
+    // One row group being filled or written: stored integers by column.
+    struct RowGroup
+    {
+        std::vector<std::int64_t> columns[ColumnarFormat::COLUMN_COUNT];
+        std::uint32_t rows = 0;
+    };
+
+    // Footer entry of one written row group.
+    struct ChunkMeta
+    {
+        std::uint64_t offset;
+        std::uint32_t bytes;
+        std::int64_t min;
+        std::int64_t max;
+    };
+
+    struct RowGroupMeta
+    {
+        std::uint32_t rows;
+        ChunkMeta chunks[ColumnarFormat::COLUMN_COUNT];
+    };
+
+    void writerLoop(); // Writer thread body.
+
+    void writeRowGroup(RowGroup &group); // Sorts, encodes and writes one row group (writer thread).
+
+    void submit(); // Hands the current row group to the writer (tick thread).
+
+    RowGroup *takeFree(); // A free buffer, or null if the writer holds them all.
+
+    bool writeFooter(); // Footer and trailing magic (after the writer stopped).
+
+    std::FILE *m_file = nullptr;
+    std::uint32_t m_rowGroupRows = 0;
+    std::uint64_t m_offset = 0; // File position of the next chunk (writer thread).
+    bool m_writeFailed = false; // A write failed: later row groups are dropped (writer thread).
+
+    std::vector<std::unique_ptr<RowGroup>> m_groups; // The buffer pool.
+    RowGroup *m_current = nullptr;                   // Being filled by the tick thread, or null.
+
+    // --- hand-off (taken once per row group, not per row) ---
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::vector<RowGroup *> m_full; // Waiting for the writer, oldest first.
+    std::vector<RowGroup *> m_free;
+    std::atomic<int> m_freeCount{0};
+    bool m_stopping = false;
+    std::thread m_writer;
+
+    // --- writer thread ---
+    std::vector<unsigned char> m_encoded;   // Scratch: one chunk.
+    std::vector<std::int64_t> m_sorted;     // Scratch: one column in drone order.
+    std::vector<std::uint32_t> m_order;     // Scratch: row permutation.
+    std::vector<std::uint32_t> m_histogram; // Scratch: rows per drone.
+    std::vector<RowGroupMeta> m_meta;
+
+    std::vector<std::string> m_ids; // UTF-8 ids by drone index.
+
+    std::atomic<std::uint64_t> m_rowsRecorded{0};
+    std::atomic<std::uint64_t> m_rowsDropped{0};
+    std::atomic<std::uint64_t> m_bytesWritten{0};
+};
@@ -0,0 +1,93 @@
+#include "CommandQueue.h"
+
+// Bounded MPSC ring based on per-slot sequence numbers (D. Vyukov's design):
+// a slot is free for the producer at position p when sequence == p, and ready
+// for the consumer when sequence == p + 1.
+
+CommandQueue::CommandQueue(std::size_t capacity)
+{
+
+    std::size_t size = 2;
+
+    while (size < capacity)
+        size <<= 1;
+
+    m_cells.reset(new Cell[size]);
+
+    m_mask = size - 1;
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+
+        m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+bool CommandQueue::push(const FleetCommand &cmd)
+{
+
+    std::size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+
+    for (;;)
+    {
+
+        Cell &cell = m_cells[pos & m_mask];
+
+        std::size_t seq = cell.sequence.load(std::memory_order_acquire);
+
+        std::ptrdiff_t diff = std::ptrdiff_t(seq) - std::ptrdiff_t(pos);
+
+        if (diff == 0)
+        {
+
+            // slot is free, try to claim it
+
+            if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+
+                cell.command = cmd;
+
+                cell.sequence.store(pos + 1, std::memory_order_release);
+
+                return true;
+            }
+        }
+        else if (diff < 0)
+        {
+
+            // consumer has not freed this slot yet: queue is full
+
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+
+            return false;
+        }
+        else
+        {
+
+            pos = m_enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool CommandQueue::pop(FleetCommand &out)
+{
+
+    std::size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+
+    Cell &cell = m_cells[pos & m_mask];
+
+    std::size_t seq = cell.sequence.load(std::memory_order_acquire);
+
+    if (std::ptrdiff_t(seq) - std::ptrdiff_t(pos + 1) < 0)
+        return false; // nothing published at this position yet
+
+    out = cell.command;
+
+    m_dequeuePos.store(pos + 1, std::memory_order_relaxed);
+
+    // hand the slot back to producers for the next lap
+
+    cell.sequence.store(pos + m_mask + 1, std::memory_order_release);
+
+    return true;
+}
@@ -0,0 +1,56 @@
+/******************************************************************************
+ * CommandQueue.h
+ * Author: Jatin Kumawat
+ * Date: 19-10-2026
+ *
+ * Description:
+ *   Bounded lock-free multi-producer / single-consumer queue of FleetCommand.
+ *
+ *   - Any thread may push (UI, scripting, network) without taking a lock
+ *   - The simulator thread drains it once per tick
+ *   - Storage is allocated once in the constructor, push/pop never allocate
+ ******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include "FleetCommand.h"
+
+class CommandQueue
+{
+public:
+    explicit CommandQueue(std::size_t capacity = 1024); // Capacity is rounded up to a power of two.
+
+    CommandQueue(const CommandQueue &) = delete;
+    CommandQueue &operator=(const CommandQueue &) = delete;
+
+    // Thread-safe: enqueues a command. Returns false if the queue is full.
+    bool push(const FleetCommand &cmd);
+
+    // Consumer side only: dequeues the oldest command. Returns false if empty.
+    bool pop(FleetCommand &out);
+
+    std::size_t capacity() const { return m_mask + 1; } // Number of slots in the ring.
+
+    std::size_t dropped() const { return m_dropped.load(std::memory_order_relaxed); } // Pushes rejected because the queue was full.
+
+private:
+    // One ring slot. The sequence number tells producers/consumer whose turn it is.
+    struct Cell
+    {
+        std::atomic<std::size_t> sequence{0};
+        FleetCommand command;
+    };
+
+    std::unique_ptr<Cell[]> m_cells; // Ring storage, allocated once.
+
+    std::size_t m_mask = 0; // capacity - 1, used to wrap indices.
+
+    alignas(64) std::atomic<std::size_t> m_enqueuePos{0}; // Next slot producers claim.
+
+    alignas(64) std::atomic<std::size_t> m_dequeuePos{0}; // Next slot the consumer reads.
+
+    alignas(64) std::atomic<std::size_t> m_dropped{0}; // Rejected pushes (statistics only).
+};
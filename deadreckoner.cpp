@@ -0,0 +1,237 @@
+#include "DeadReckoner.h"
+
+#include <algorithm>
+
+#include <cmath>
+
+#include "FastTrig.h"
+
+// shortest signed turn from a to b, degrees in [-180, 180)
+
+static double turn(double a, double b)
+{
+
+    const double d = std::fmod(b - a + 540.0, 360.0);
+
+    return d - 180.0;
+}
+
+std::array<std::vector<double> *, 22> DeadReckoner::doubleColumns()
+{
+
+    return {&m_fromEast, &m_fromNorth, &m_fromAlt, &m_fromVe, &m_fromVn, &m_fromClimb, &m_fromHeading,
+            &m_east, &m_north, &m_alt, &m_ve, &m_vn, &m_climb, &m_heading, &m_blendMs,
+            &m_showEast, &m_showNorth, &m_showAlt, &m_showHeading, &m_showVe, &m_showVn, &m_showClimb};
+}
+
+int DeadReckoner::addTrack(const TelemetrySnapshot &snap)
+{
+
+    const int k = int(m_ids.size());
+
+    m_index.insert(snap.id, k);
+
+    m_ids.push_back(snap.id);
+
+    m_last.push_back(snap);
+
+    for (std::vector<double> *column : doubleColumns())
+        column->push_back(0.0);
+
+    m_arrivalMs.push_back(0);
+
+    m_sampleMs.push_back(0);
+
+    return k;
+}
+
+int DeadReckoner::update(const TelemetrySnapshot &snap, qint64 arrivalMs)
+{
+
+    if (!m_anchored)
+    {
+
+        m_frame = EnuFrame(snap.latitude, snap.longitude);
+
+        m_anchored = true;
+    }
+
+    int k = find(snap.id);
+
+    const bool first = k < 0;
+
+    if (first)
+        k = addTrack(snap);
+
+    double east = 0.0, north = 0.0;
+
+    m_frame.toEnu(snap.latitude, snap.longitude, east, north);
+
+    double s = 0.0, c = 1.0;
+
+    FastTrig::sinCos(snap.heading * FastTrig::DEG_TO_RAD, s, c);
+
+    const double ve = s * snap.speed;
+
+    const double vn = c * snap.speed;
+
+    if (first)
+    {
+
+        // nothing drawn yet: start on the sample, no blend
+
+        m_fromEast[k] = m_showEast[k] = east;
+
+        m_fromNorth[k] = m_showNorth[k] = north;
+
+        m_fromAlt[k] = m_showAlt[k] = snap.altitude;
+
+        m_fromHeading[k] = m_showHeading[k] = snap.heading;
+
+        m_fromVe[k] = m_showVe[k] = ve;
+
+        m_fromVn[k] = m_showVn[k] = vn;
+
+        m_fromClimb[k] = m_showClimb[k] = 0.0;
+
+        m_climb[k] = 0.0;
+
+        m_blendMs[k] = 0.0;
+    }
+    else
+    {
+
+        // the last two samples give the climb rate and how long to blend (one sample interval)
+
+        const qint64 interval = snap.timestampMs - m_sampleMs[k];
+
+        if (interval > 0)
+        {
+
+            m_climb[k] = (snap.altitude - m_alt[k]) * 1000.0 / double(interval);
+
+            m_blendMs[k] = double(std::clamp<qint64>(interval, 16, 2000));
+        }
+
+        // the path being drawn right now is where the blend starts
+
+        m_fromEast[k] = m_showEast[k];
+
+        m_fromNorth[k] = m_showNorth[k];
+
+        m_fromAlt[k] = m_showAlt[k];
+
+        m_fromHeading[k] = m_showHeading[k];
+
+        m_fromVe[k] = m_showVe[k];
+
+        m_fromVn[k] = m_showVn[k];
+
+        m_fromClimb[k] = m_showClimb[k];
+    }
+
+    m_east[k] = east;
+
+    m_north[k] = north;
+
+    m_alt[k] = snap.altitude;
+
+    m_heading[k] = snap.heading;
+
+    m_ve[k] = ve;
+
+    m_vn[k] = vn;
+
+    m_arrivalMs[k] = arrivalMs;
+
+    m_sampleMs[k] = snap.timestampMs;
+
+    m_last[k] = snap;
+
+    return k;
+}
+
+void DeadReckoner::advance(qint64 nowMs)
+{
+
+    const int n = trackCount();
+
+    for (int k = 0; k < n; ++k)
+    {
+
+        const qint64 since = std::max<qint64>(nowMs - m_arrivalMs[k], 0);
+
+        // both paths stop at the extrapolation limit
+
+        const bool moving = since < m_maxExtrapolationMs;
+
+        const double dt = double(std::min(since, m_maxExtrapolationMs)) / 1000.0;
+
+        const double a = m_blendMs[k] > 0.0 ? std::min(double(since) / m_blendMs[k], 1.0) : 1.0;
+
+        const double newEast = m_east[k] + m_ve[k] * dt;
+
+        const double newNorth = m_north[k] + m_vn[k] * dt;
+
+        const double newAlt = m_alt[k] + m_climb[k] * dt;
+
+        const double oldEast = m_fromEast[k] + m_fromVe[k] * dt;
+
+        const double oldNorth = m_fromNorth[k] + m_fromVn[k] * dt;
+
+        const double oldAlt = m_fromAlt[k] + m_fromClimb[k] * dt;
+
+        m_showEast[k] = oldEast + (newEast - oldEast) * a;
+
+        m_showNorth[k] = oldNorth + (newNorth - oldNorth) * a;
+
+        m_showAlt[k] = oldAlt + (newAlt - oldAlt) * a;
+
+        const double heading = m_fromHeading[k] + turn(m_fromHeading[k], m_heading[k]) * a;
+
+        m_showHeading[k] = heading < 0.0 ? heading + 360.0 : (heading >= 360.0 ? heading - 360.0 : heading);
+
+        // the velocity drawn now is where the next blend starts from
+
+        const double v = moving ? 1.0 : 0.0;
+
+        m_showVe[k] = v * (m_fromVe[k] + (m_ve[k] - m_fromVe[k]) * a);
+
+        m_showVn[k] = v * (m_fromVn[k] + (m_vn[k] - m_fromVn[k]) * a);
+
+        m_showClimb[k] = v * (m_fromClimb[k] + (m_climb[k] - m_fromClimb[k]) * a);
+    }
+}
+
+TelemetrySnapshot DeadReckoner::displayed(int k) const
+{
+
+    TelemetrySnapshot snap = m_last[k];
+
+    m_frame.toGeodetic(m_showEast[k], m_showNorth[k], snap.latitude, snap.longitude);
+
+    snap.altitude = m_showAlt[k];
+
+    snap.heading = m_showHeading[k];
+
+    return snap;
+}
+
+void DeadReckoner::clear()
+{
+
+    m_anchored = false;
+
+    m_index.clear();
+
+    m_ids.clear();
+
+    m_last.clear();
+
+    for (std::vector<double> *column : doubleColumns())
+        column->clear();
+
+    m_arrivalMs.clear();
+
+    m_sampleMs.clear();
+}
@@ -0,0 +1,82 @@
+/******************************************************************************
+ * DeadReckoner.h
+ * Author: Jatin Kumawat
+ * Date: 19-10-2026
+ *
+ * Description:
+ *   Display-side motion smoothing between telemetry samples.
+ *
+ *   - Extrapolates every drone from its last sample with the reported speed
+ *  and heading, and its climb rate from the last two samples
+ *   - When a new sample arrives the displayed track does not jump: it blends
+ *  from where it is drawn toward the new dead-reckoned path over one sample
+ *  interval (projective velocity blending)
+ *   - Extrapolation stops after a configurable time so a silent drone holds
+ *  still instead of flying away
+ *   - Columnar per-track state; advance() updates every track in one pass,
+ *  so the display can run at 60 fps for thousands of drones while the
+ *  simulator ticks slowly
+ ******************************************************************************/
+
+#pragma once
+
+#include <QHash>
+#include <QString>
+#include <array>
+#include <vector>
+#include "TelemetryTypes.h"
+#include "EnuFrame.h"
+
+class DeadReckoner
+{
+public:
+    // Stop extrapolating a track this long after its last sample (link loss, paused drone).
+    void setMaxExtrapolationMs(qint64 ms) { m_maxExtrapolationMs = ms; }
+
+    // Feeds a received sample. arrivalMs is the display clock when it arrived. Returns the track index.
+    int update(const TelemetrySnapshot &snap, qint64 arrivalMs);
+
+    // Moves every track to display time nowMs. Call once per rendered frame.
+    void advance(qint64 nowMs);
+
+    int trackCount() const { return int(m_ids.size()); }
+
+    int find(const QString &id) const { return m_index.value(id, -1); } // Track of a drone, or -1.
+
+    // Displayed pose of track k after the last advance(): the last sample with position,
+    // altitude and heading replaced by their smoothed values.
+    TelemetrySnapshot displayed(int k) const;
+
+    void clear(); // Forgets every track.
+
+private:
+    int addTrack(const TelemetrySnapshot &snap); // Appends a track for a new drone id.
+
+    std::array<std::vector<double> *, 22> doubleColumns(); // Every per-track double column (grow/clear together).
+
+    qint64 m_maxExtrapolationMs = 1500;
+
+    EnuFrame m_frame;       // Display plane, anchored at the first sample received.
+    bool m_anchored = false;
+
+    QHash<QString, int> m_index; // Drone id -> track.
+    std::vector<QString> m_ids;
+    std::vector<TelemetrySnapshot> m_last; // Last sample (non-kinematic fields are shown as is).
+
+    // --- path drawn before the last sample arrived, frozen at its arrival ---
+    std::vector<double> m_fromEast, m_fromNorth, m_fromAlt; // Displayed position at arrival.
+    std::vector<double> m_fromVe, m_fromVn, m_fromClimb;    // Displayed velocity at arrival.
+    std::vector<double> m_fromHeading;
+
+    // --- dead-reckoned path of the last sample ---
+    std::vector<double> m_east, m_north, m_alt; // Sample position (meters in the display plane).
+    std::vector<double> m_ve, m_vn, m_climb;    // m/s from speed/heading and the last two altitudes.
+    std::vector<double> m_heading;
+    std::vector<qint64> m_arrivalMs;  // Display time the sample arrived.
+    std::vector<qint64> m_sampleMs;   // Sample timestamp (for the interval between samples).
+    std::vector<double> m_blendMs;    // Blend duration = last sample interval.
+
+    // --- displayed pose (advance() output) ---
+    std::vector<double> m_showEast, m_showNorth, m_showAlt, m_showHeading;
+    std::vector<double> m_showVe, m_showVn, m_showClimb;
+};
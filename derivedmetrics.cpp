@@ -0,0 +1,289 @@
+#include "DerivedMetrics.h"
+
+#include <algorithm>
+
+#include <cmath>
+
+#include <limits>
+
+static constexpr unsigned bit(int metric) { return 1u << metric; }
+
+static const double NaN = std::numeric_limits<double>::quiet_NaN();
+
+static const double INF = std::numeric_limits<double>::infinity();
+
+void DerivedMetrics::subscribe(int metric)
+{
+
+    if (metric < 0 || metric >= DerivedMetric::Count)
+        return;
+
+    const unsigned before = m_mask;
+
+    ++m_subscribers[metric];
+
+    m_mask = computedMask();
+
+    // metrics that were idle start over: they missed every sample since
+
+    for (int m = 0; m < DerivedMetric::Count; ++m)
+    {
+
+        if ((m_mask & bit(m)) && !(before & bit(m)))
+            resetState(m);
+    }
+}
+
+void DerivedMetrics::unsubscribe(int metric)
+{
+
+    if (metric < 0 || metric >= DerivedMetric::Count || m_subscribers[metric] == 0)
+        return;
+
+    --m_subscribers[metric];
+
+    m_mask = computedMask();
+}
+
+unsigned DerivedMetrics::computedMask() const
+{
+
+    unsigned mask = 0;
+
+    for (int m = 0; m < DerivedMetric::Count; ++m)
+    {
+
+        if (m_subscribers[m] > 0)
+            mask |= bit(m);
+    }
+
+    if (mask & bit(DerivedMetric::RemainingRange))
+        mask |= bit(DerivedMetric::RemainingFlightTime) | bit(DerivedMetric::GroundSpeedAverage);
+
+    if (mask & bit(DerivedMetric::TimeToHome))
+        mask |= bit(DerivedMetric::DistanceToHome) | bit(DerivedMetric::GroundSpeedAverage);
+
+    return mask;
+}
+
+void DerivedMetrics::resetState(int metric)
+{
+
+    std::fill(m_value[metric].begin(), m_value[metric].end(), NaN);
+
+    switch (metric)
+    {
+
+    case DerivedMetric::PathLength:
+
+        std::fill(m_path.begin(), m_path.end(), 0.0);
+
+        std::fill(m_lastEast.begin(), m_lastEast.end(), NaN); // the next sample is the starting point
+
+        break;
+
+    case DerivedMetric::GroundSpeedAverage:
+
+        std::fill(m_speedAvg.begin(), m_speedAvg.end(), NaN);
+
+        break;
+
+    case DerivedMetric::RemainingFlightTime:
+
+        for (std::vector<double> *sum : {&m_sw, &m_st, &m_sb, &m_stt, &m_stb})
+            std::fill(sum->begin(), sum->end(), 0.0);
+
+        break;
+
+    default:
+
+        break;
+    }
+}
+
+int DerivedMetrics::addTrack(const TelemetrySnapshot &snap, double east, double north)
+{
+
+    const int k = int(m_ids.size());
+
+    m_index.insert(snap.id, k);
+
+    m_ids.push_back(snap.id);
+
+    m_homeEast.push_back(east);
+
+    m_homeNorth.push_back(north);
+
+    m_lastEast.push_back(NaN); // path starts at the next computed sample
+
+    m_lastNorth.push_back(north);
+
+    m_lastAlt.push_back(snap.altitude);
+
+    m_lastMs.push_back(snap.timestampMs);
+
+    m_path.push_back(0.0);
+
+    m_speedAvg.push_back(NaN);
+
+    for (std::vector<double> *sum : {&m_sw, &m_st, &m_sb, &m_stt, &m_stb})
+        sum->push_back(0.0);
+
+    for (std::vector<double> &column : m_value)
+        column.push_back(NaN);
+
+    return k;
+}
+
+int DerivedMetrics::update(const TelemetrySnapshot &snap)
+{
+
+    if (!m_anchored)
+    {
+
+        m_frame = EnuFrame(snap.latitude, snap.longitude);
+
+        m_anchored = true;
+    }
+
+    double east = 0.0, north = 0.0;
+
+    m_frame.toEnu(snap.latitude, snap.longitude, east, north);
+
+    int k = find(snap.id);
+
+    if (k < 0)
+        k = addTrack(snap, east, north);
+
+    const unsigned mask = m_mask;
+
+    // out-of-order samples do not move the time-based state backwards
+
+    const double dt = double(snap.timestampMs - m_lastMs[k]) / 1000.0;
+
+    const bool forward = dt >= 0.0;
+
+    if (forward)
+        m_lastMs[k] = snap.timestampMs;
+
+    if (mask & bit(DerivedMetric::DistanceToHome))
+        m_value[DerivedMetric::DistanceToHome][k] = std::hypot(east - m_homeEast[k], north - m_homeNorth[k]);
+
+    if (mask & bit(DerivedMetric::PathLength))
+    {
+
+        if (!std::isnan(m_lastEast[k]))
+        {
+
+            const double de = east - m_lastEast[k], dn = north - m_lastNorth[k], du = snap.altitude - m_lastAlt[k];
+
+            m_path[k] += std::sqrt(de * de + dn * dn + du * du);
+        }
+
+        m_lastEast[k] = east;
+
+        m_lastNorth[k] = north;
+
+        m_lastAlt[k] = snap.altitude;
+
+        m_value[DerivedMetric::PathLength][k] = m_path[k];
+    }
+
+    if (mask & bit(DerivedMetric::GroundSpeedAverage))
+    {
+
+        // exponential average: the same weight for an interval whatever the sample rate
+
+        if (std::isnan(m_speedAvg[k]))
+            m_speedAvg[k] = snap.speed;
+        else if (forward)
+            m_speedAvg[k] += (1.0 - std::exp(-dt / m_speedWindow)) * (snap.speed - m_speedAvg[k]);
+
+        m_value[DerivedMetric::GroundSpeedAverage][k] = m_speedAvg[k];
+    }
+
+    if ((mask & bit(DerivedMetric::RemainingFlightTime)) && forward)
+    {
+
+        // weighted least squares of battery over time, time measured back from this sample:
+        // shift the origin by dt, decay the old weights, add the new point at t = 0
+
+        const double decay = std::exp(-dt / m_batteryWindow);
+
+        const double sw = m_sw[k], st = m_st[k];
+
+        m_stt[k] = (m_stt[k] - 2.0 * dt * st + dt * dt * sw) * decay;
+
+        m_stb[k] = (m_stb[k] - dt * m_sb[k]) * decay;
+
+        m_st[k] = (st - dt * sw) * decay;
+
+        m_sw[k] = sw * decay + 1.0;
+
+        m_sb[k] = m_sb[k] * decay + double(snap.battery);
+
+        const double den = m_sw[k] * m_stt[k] - m_st[k] * m_st[k];
+
+        double remaining = NaN;
+
+        if (den > 1e-9 * m_sw[k] * m_sw[k])
+        {
+
+            const double slope = (m_sw[k] * m_stb[k] - m_st[k] * m_sb[k]) / den; // percent per second
+
+            const double level = (m_sb[k] - slope * m_st[k]) / m_sw[k];          // fitted battery now
+
+            remaining = slope < -1e-9 ? std::max(level, 0.0) / -slope : INF;
+        }
+
+        m_value[DerivedMetric::RemainingFlightTime][k] = remaining;
+    }
+
+    const double speed = m_speedAvg[k];
+
+    if (mask & bit(DerivedMetric::RemainingRange))
+    {
+
+        const double time = m_value[DerivedMetric::RemainingFlightTime][k];
+
+        m_value[DerivedMetric::RemainingRange][k] = speed > 1e-3 ? time * speed : (std::isnan(time) ? NaN : 0.0);
+    }
+
+    if (mask & bit(DerivedMetric::TimeToHome))
+    {
+
+        const double distance = m_value[DerivedMetric::DistanceToHome][k];
+
+        m_value[DerivedMetric::TimeToHome][k] = speed > 1e-3 ? distance / speed : (distance > 0.0 ? INF : 0.0);
+    }
+
+    return k;
+}
+
+double DerivedMetrics::value(int k, int metric) const
+{
+
+    if (k < 0 || k >= trackCount() || metric < 0 || metric >= DerivedMetric::Count || !(m_mask & bit(metric)))
+        return NaN;
+
+    return m_value[metric][k];
+}
+
+void DerivedMetrics::clear()
+{
+
+    m_anchored = false;
+
+    m_index.clear();
+
+    m_ids.clear();
+
+    for (std::vector<double> *column : {&m_homeEast, &m_homeNorth, &m_lastEast, &m_lastNorth, &m_lastAlt, &m_path,
+                                        &m_speedAvg, &m_sw, &m_st, &m_sb, &m_stt, &m_stb})
+        column->clear();
+
+    m_lastMs.clear();
+
+    for (std::vector<double> &column : m_value)
+        column.clear();
+}
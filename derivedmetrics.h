@@ -0,0 +1,102 @@
+/******************************************************************************
+ * DerivedMetrics.h
+ * Author: Jatin Kumawat
+ * Date: 19-10-2026
+ *
+ * Description:
+ *   Operator-facing values derived from the telemetry stream.
+ *
+ *   - Distance to the launch point, cumulative path length, ground speed
+ *  averaged over a time window, remaining flight time from the battery
+ *  trend, remaining range and time to fly home
+ *   - Incremental: every sample updates each metric in O(1) per drone
+ *  (running sums and exponential averages, no sample history)
+ *   - Lazy: only subscribed metrics, and the metrics they are built from,
+ *  are computed; a metric nobody reads costs nothing per sample
+ ******************************************************************************/
+
+#pragma once
+
+#include <QHash>
+#include <QString>
+#include <array>
+#include <vector>
+#include "TelemetryTypes.h"
+#include "EnuFrame.h"
+
+// Metrics the engine can derive.
+namespace DerivedMetric
+{
+    enum Type
+    {
+        DistanceToHome = 0,      // Horizontal meters from the drone's first sample (launch point).
+        PathLength = 1,          // Meters flown (3D) since the metric was subscribed.
+        GroundSpeedAverage = 2,  // Reported speed averaged over the speed window (m/s).
+        RemainingFlightTime = 3, // Seconds until the battery trend reaches 0%; +inf while not draining.
+        RemainingRange = 4,      // Meters left at the average ground speed (RemainingFlightTime x GroundSpeedAverage).
+        TimeToHome = 5,          // Seconds to fly home at the average ground speed; +inf when not moving.
+        Count                    // Number of metrics (not a metric).
+    };
+}
+
+class DerivedMetrics
+{
+public:
+    // Starts computing a metric (and the metrics it needs). Subscriptions are counted.
+    void subscribe(int metric);
+
+    // Drops one subscription; the metric stops being computed when the last one is gone.
+    void unsubscribe(int metric);
+
+    bool subscribed(int metric) const { return metric >= 0 && metric < DerivedMetric::Count && m_subscribers[metric] > 0; }
+
+    // Time constant of the ground speed average (seconds).
+    void setSpeedWindowSeconds(double seconds) { m_speedWindow = seconds > 0.0 ? seconds : 1.0; }
+
+    // Time constant of the battery trend fit (seconds): older samples weigh less.
+    void setBatteryWindowSeconds(double seconds) { m_batteryWindow = seconds > 0.0 ? seconds : 1.0; }
+
+    // Feeds one sample. Updates only the computed metrics of its drone. Returns the track index.
+    int update(const TelemetrySnapshot &snap);
+
+    int trackCount() const { return int(m_ids.size()); }
+
+    int find(const QString &id) const { return m_index.value(id, -1); } // Track of a drone, or -1.
+
+    // Last value of a metric for track k, or NaN when it is not computed (or has no data yet).
+    double value(int k, int metric) const;
+
+    double value(const QString &id, int metric) const { return value(find(id), metric); }
+
+    void clear(); // Forgets every track (subscriptions are kept).
+
+private:
+    int addTrack(const TelemetrySnapshot &snap, double east, double north); // Appends a track for a new drone id.
+
+    void resetState(int metric);        // Restarts a stateful metric on every track (it was not tracked while unsubscribed).
+    unsigned computedMask() const;      // Subscribed metrics plus their inputs, one bit per metric.
+
+    std::array<int, DerivedMetric::Count> m_subscribers{}; // Subscription count per metric.
+    unsigned m_mask = 0;                                   // computedMask(), cached.
+
+    double m_speedWindow = 10.0;
+    double m_batteryWindow = 60.0;
+
+    EnuFrame m_frame; // Plane for distances, anchored at the first sample received.
+    bool m_anchored = false;
+
+    QHash<QString, int> m_index; // Drone id -> track.
+    std::vector<QString> m_ids;
+
+    // --- per track state ---
+    std::vector<double> m_homeEast, m_homeNorth;             // Launch point.
+    std::vector<double> m_lastEast, m_lastNorth, m_lastAlt; // Previous sample.
+    std::vector<qint64> m_lastMs;
+    std::vector<double> m_path;      // PathLength running sum.
+    std::vector<double> m_speedAvg;  // GroundSpeedAverage, NaN until the first sample.
+
+    // Battery trend: exponentially weighted least-squares sums, time in seconds relative to the last sample.
+    std::vector<double> m_sw, m_st, m_sb, m_stt, m_stb;
+
+    std::array<std::vector<double>, DerivedMetric::Count> m_value; // Last value per metric and track.
+};
@@ -4,6 +4,10 @@
 
 #include <QRandomGenerator>
 
+#include "Tracing.h"
+
+#include <algorithm>
+
 #include <cmath>
 
 DroneSimulator::DroneSimulator(const QString &id, QObject *parent)
@@ -12,24 +16,125 @@ DroneSimulator::DroneSimulator(const QString &id, QObject *parent)
 
       m_id(id),
 
+      m_faults(QRandomGenerator::global()->generate64()),
+
+      m_gpsNoise(QRandomGenerator::global()->generate64()),
+
       m_timer(new QTimer(this))
 
 {
 
-    m_state.id = id;
-
     connect(m_timer, &QTimer::timeout, this, &DroneSimulator::onTick);
 }
 
-void DroneSimulator::setStrategy(std::unique_ptr<MovementStrategy> strategy)
+void DroneSimulator::registerStrategy(int strategyType, std::unique_ptr<MovementStrategy> strategy)
 {
 
-    m_strategy = std::move(strategy);
+    if (strategyType < 0)
+        return;
+
+    if (strategyType >= int(m_strategies.size()))
+        m_strategies.resize(strategyType + 1);
+
+    m_strategies[strategyType] = std::move(strategy);
+
+    m_members.resize(m_strategies.size());
+
+    m_members[strategyType].reserve(m_fleet.size());
+}
+
+MovementStrategy *DroneSimulator::strategyFor(int strategyType) const
+{
+
+    if (strategyType < 0 || strategyType >= int(m_strategies.size()))
+        return nullptr;
+
+    return m_strategies[strategyType].get();
+}
+
+int DroneSimulator::addDrone(const QString &droneId, int group, int strategyType)
+{
+
+    const int index = m_fleet.add(droneId, group, strategyType);
+
+    m_faults.resize(m_fleet.size());
+
+    m_gpsNoise.resize(m_fleet.size());
+
+    m_filter.resize(m_fleet.size());
+
+    m_published.resize(m_fleet.size());
+
+    // worst case every drone runs the same strategy: no growth during ticks
+
+    for (std::vector<int> &members : m_members)
+        members.reserve(m_fleet.size());
+
+    m_bus.setId(index, droneId);
+
+    if (m_udp.isOpen())
+        m_udp.setId(index, droneId);
+
+    m_recorder.setId(index, droneId);
+
+    return index;
+}
+
+bool DroneSimulator::openTelemetryBus(const QString &name, QString *error, bool replaceExisting)
+{
+
+    // sized for the current fleet; drones added later than this are not published on the bus
+
+    if (!m_bus.open(name, std::uint32_t(m_fleet.size()), error, replaceExisting))
+        return false;
+
+    for (int i = 0; i < m_fleet.size(); ++i)
+        m_bus.setId(i, m_fleet.id[i]);
+
+    return true;
+}
+
+bool DroneSimulator::openUdpPublisher(const QString &host, quint16 port, QString *error)
+{
+
+    // one tick of the whole fleet fits in the ring twice over
+
+    const std::size_t datagramsPerTick = std::size_t(m_fleet.size()) / TelemetryWire::RECORDS_PER_DATAGRAM + 2;
+
+    if (!m_udp.open(host, port, std::max<std::size_t>(1024, 2 * datagramsPerTick), error))
+        return false;
+
+    for (int i = 0; i < m_fleet.size(); ++i)
+        m_udp.setId(i, m_fleet.id[i]);
+
+    return true;
+}
+
+bool DroneSimulator::openRecording(const QString &path, QString *error)
+{
+
+    if (!m_recorder.open(path, 65536, 4, error))
+        return false;
+
+    for (int i = 0; i < m_fleet.size(); ++i)
+        m_recorder.setId(i, m_fleet.id[i]);
+
+    return true;
+}
+
+bool DroneSimulator::submitCommand(const FleetCommand &cmd)
+{
+
+    return m_commands.push(cmd);
 }
 
 void DroneSimulator::start()
 {
 
+    // runs on the worker thread once moved there
+
+    Tracing::setThreadName("simulator");
+
     m_lastUpdate = QDateTime::currentDateTime();
 
     m_timer->start(500);
@@ -41,12 +146,122 @@ void DroneSimulator::stop()
     m_timer->stop();
 }
 
-void DroneSimulator::onTick()
+void DroneSimulator::applyPendingCommands()
 {
 
-    if (!m_strategy)
+    // bounded by the ring size so producers cannot keep the tick busy forever
 
-        return;
+    const std::size_t budget = m_commands.capacity();
+
+    FleetCommand cmd;
+
+    for (std::size_t n = 0; n < budget && m_commands.pop(cmd); ++n)
+    {
+
+        const int count = m_fleet.size();
+
+        switch (cmd.scope)
+        {
+
+        case FleetCommand::Scope::Drone:
+
+            if (cmd.target >= 0 && cmd.target < count)
+                applyCommand(cmd, cmd.target);
+
+            break;
+
+        case FleetCommand::Scope::Group:
+
+            for (int i = 0; i < count; ++i)
+            {
+
+                if (m_fleet.group[i] == cmd.target)
+                    applyCommand(cmd, i);
+            }
+
+            break;
+
+        case FleetCommand::Scope::Fleet:
+
+            for (int i = 0; i < count; ++i)
+                applyCommand(cmd, i);
+
+            break;
+        }
+    }
+}
+
+void DroneSimulator::applyCommand(const FleetCommand &cmd, int drone)
+{
+
+    switch (cmd.type)
+    {
+
+    case FleetCommand::Type::SetStrategy:
+    {
+
+        const int strategyType = int(cmd.value);
+
+        // ignore types that were never registered
+
+        if (strategyFor(strategyType))
+            m_fleet.strategy[drone] = strategyType;
+
+        break;
+    }
+
+    case FleetCommand::Type::SetFailureMode:
+
+        m_fleet.failure[drone] = cmd.value != 0.0 ? 1 : 0;
+
+        break;
+
+    case FleetCommand::Type::OverrideSpeed:
+
+        m_fleet.speedOverride[drone] = std::max(0.0, cmd.value);
+
+        break;
+
+    case FleetCommand::Type::OverrideAltitude:
+
+        m_fleet.altitudeOverride[drone] = cmd.value;
+
+        break;
+
+    case FleetCommand::Type::ClearOverrides:
+
+        m_fleet.speedOverride[drone] = std::nan("");
+
+        m_fleet.altitudeOverride[drone] = std::nan("");
+
+        break;
+
+    case FleetCommand::Type::Pause:
+
+        m_fleet.paused[drone] = 1;
+
+        break;
+
+    case FleetCommand::Type::Resume:
+
+        m_fleet.paused[drone] = 0;
+
+        // receivers saw the drone go silent: announce it again even if it did not move
+
+        m_filter.invalidate(drone);
+
+        break;
+
+    case FleetCommand::Type::SetFaultProfile:
+
+        m_faults.assignProfile(drone, int(cmd.value));
+
+        break;
+    }
+}
+
+void DroneSimulator::onTick()
+{
 
     auto now = QDateTime::currentDateTime();
 
@@ -54,27 +269,152 @@ void DroneSimulator::onTick()
 
     m_lastUpdate = now;
 
-    TelemetrySnapshot next = m_strategy->step(m_state, dt);
+    advance(dt, now.toMSecsSinceEpoch());
+}
+
+void DroneSimulator::advance(double dt, qint64 nowMs)
+{
+
+    // heap use inside the tick is charged to the simulator unless a nested scope says otherwise
+
+    TickScope tick;
+
+    TraceScope trace("tick", "simulator", "drones", m_fleet.size());
+
+    // commands queued since the last tick take effect before anything moves
+
+    applyPendingCommands();
+
+    const int count = m_fleet.size();
+
+    // bucket active drones by strategy (lists keep their capacity between ticks)
+
+    for (std::vector<int> &members : m_members)
+        members.clear();
+
+    for (int i = 0; i < count; ++i)
+    {
+
+        if (!m_fleet.paused[i] && strategyFor(m_fleet.strategy[i]))
+            m_members[m_fleet.strategy[i]].push_back(i);
+    }
+
+    // one batched call per strategy
+
+    {
+
+        MemoryScope scope(MemorySubsystem::Strategies);
+
+        for (std::size_t k = 0; k < m_members.size(); ++k)
+        {
+
+            if (m_members[k].empty())
+                continue;
+
+            TraceScope batch("stepBatch", "simulator", "drones", double(m_members[k].size()));
+
+            m_strategies[k]->stepBatch(m_fleet, m_members[k], dt);
+        }
+    }
+
+    for (std::size_t k = 0; k < m_members.size(); ++k)
+    {
+
+        const bool fixedDrain = !m_strategies[k] || !m_strategies[k]->modelsBattery();
+
+        for (int i : m_members[k])
+        {
+
+            // operator overrides win over the strategy
 
-    // Add tiny GPS drift
+            if (!std::isnan(m_fleet.speedOverride[i]))
+                m_fleet.speed[i] = m_fleet.speedOverride[i];
 
-    next.latitude += randRange(-1e-6, 1e-6);
+            if (!std::isnan(m_fleet.altitudeOverride[i]))
+                m_fleet.altitude[i] = m_fleet.altitudeOverride[i];
 
-    next.longitude += randRange(-1e-6, 1e-6);
+            // Auto battery drain (failing drones drain faster)
 
-    // Simulate GPS loss
+            if (fixedDrain)
+                m_fleet.battery[i] = std::max(0, m_fleet.battery[i] - (m_fleet.failure[i] ? 3 : 1));
 
-    if (randRange(0.0, 1.0) < 0.01)
+            m_fleet.timestampMs[i] = nowMs;
+        }
+    }
+
+    // fault chains run once over the whole fleet (GPS fix, battery sag, sensors, link)
+
+    m_faults.step(m_fleet, dt);
+
+    // receiver error follows the fix quality the fault chains just produced
+
+    m_gpsNoise.step(m_fleet, dt);
+
+    // what each running drone sends, so the deadbands compare what receivers actually get
+
+    for (int i = 0; i < count; ++i)
     {
 
-        next.gpsFix = TelemetrySnapshot::GpsFix::NoFix;
+        if (m_fleet.paused[i] || m_faults.linkLost(i))
+            continue;
+
+        TelemetrySnapshot &published = m_published[i];
+
+        published = m_fleet.snapshot(i);
+
+        m_gpsNoise.apply(m_fleet, i, published);
+
+        m_faults.applySensorFaults(i, published);
     }
 
-    // Auto battery drain
+    // one batched deadband pass decides who publishes (the fix chain may have changed above)
 
-    next.battery = std::max(0, next.battery - 1);
+    m_filter.evaluate(m_fleet, nowMs, m_faults.linkLostFlags(), m_published.data());
 
-    m_state = next;
+    // the bus frame and UDP datagrams are filled in the same pass (no-ops while closed)
 
-    emit simulatedTick(next);
-}
\ No newline at end of file
+    TraceScope publish("publish", "simulator");
+
+    m_bus.beginFrame(count, nowMs);
+
+    m_udp.beginTick(nowMs);
+
+    for (int i = 0; i < count; ++i)
+    {
+
+        if (m_fleet.paused[i] || m_faults.linkLost(i))
+        {
+
+            m_bus.markStale(i, m_fleet.paused[i] ? TelemetryBus::Paused : TelemetryBus::LinkLost);
+
+            continue;
+        }
+
+        const TelemetrySnapshot &published = m_published[i];
+
+        m_bus.write(i, published);
+
+        // recordings keep every sample, filtered or not
+
+        m_recorder.record(i, published);
+
+        // the bus mirrors the full fleet state; the network and the UI only get drones that changed
+
+        if (!m_filter.passes(i))
+            continue;
+
+        m_filter.markPublished(m_fleet, i, nowMs, &published);
+
+        m_udp.add(i, published);
+
+        // queued connections copy the snapshot into an event on the heap
+
+        MemoryScope scope(MemorySubsystem::Events);
+
+        emit simulatedTick(published);
+    }
+
+    m_bus.commitFrame();
+
+    m_udp.endTick();
+}
@@ -20,8 +20,19 @@
 #include <QObject>
 #include <QDateTime>
 #include <memory>
+#include <vector>
 #include "TelemetryTypes.h"
 #include "MovementStrategy.h"
+#include "FleetState.h"
+#include "FleetCommand.h"
+#include "CommandQueue.h"
+#include "FaultInjector.h"
+#include "GpsNoiseModel.h"
+#include "PublicationFilter.h"
+#include "TelemetryBusWriter.h"
+#include "UdpPublisher.h"
+#include "ColumnarRecorder.h"
+#include "MemoryAccounting.h"
 #include "utils.h"
 
 class DroneSimulator : public QObject
@@ -35,7 +46,47 @@ public:
 
     void stop(); // Stops the simulation timer.
 
-    void setStrategy(std::unique_ptr<MovementStrategy> strategy); // Sets the movement behavior (Strategy Pattern).
+    // Runs one tick of dt seconds stamped nowMs, without the timer: headless and accelerated runs
+    // (soak tests) call it in a loop. Do not mix with start().
+    void advance(double dt, qint64 nowMs);
+
+    // Installs the instance used for a StrategyType (Strategy Pattern). Call before start().
+    void registerStrategy(int strategyType, std::unique_ptr<MovementStrategy> strategy);
+
+    // Adds a drone to the fleet and returns its index. Call before start().
+    int addDrone(const QString &droneId, int group, int strategyType);
+
+    // Thread-safe and lock-free: queues a command for the next tick. Returns false if the queue is full.
+    bool submitCommand(const FleetCommand &cmd);
+
+    std::size_t commandsDropped() const { return m_commands.dropped(); } // Commands rejected because the queue was full.
+
+    int droneCount() const { return m_fleet.size(); } // Number of simulated drones.
+
+    FaultInjector &faultInjector() { return m_faults; } // Fault profiles. Configure before start().
+
+    GpsNoiseModel &gpsNoise() { return m_gpsNoise; } // Receiver error model. Configure before start().
+
+    // Deadbands deciding which drones are emitted and sent over UDP each tick, and the
+    // suppression statistics. Configure before start(); the bus always gets every drone.
+    PublicationFilter &publicationFilter() { return m_filter; }
+
+    // Publishes every tick's fleet telemetry to the shared-memory bus name (e.g. "/drone-telemetry")
+    // for external reader processes. Call after the drones are added and before start().
+    // Fails if another running simulator publishes on name, unless replaceExisting is set.
+    bool openTelemetryBus(const QString &name, QString *error = nullptr, bool replaceExisting = false);
+
+    // Streams every tick's fleet telemetry to host:port over UDP (binary, see TelemetryWire.h).
+    // Call before start(); packing runs on the tick thread, sending on the publisher's own thread.
+    bool openUdpPublisher(const QString &host, quint16 port, QString *error = nullptr);
+
+    const UdpPublisher &udpPublisher() const { return m_udp; } // Send statistics.
+
+    // Records every live drone's published telemetry into a columnar file at path for offline
+    // analytics (see ColumnarFormat.h). Call before start(); the file is finished when the simulator is destroyed.
+    bool openRecording(const QString &path, QString *error = nullptr);
+
+    const ColumnarRecorder &recorder() const { return m_recorder; } // Recording statistics.
 
 signals:
 
@@ -48,15 +99,39 @@ private slots:
     void onTick(); // Slot: Called every time the internal timer fires.
 
 private:
-    QString m_id; // Unique identifier for this drone instance.
+    void applyPendingCommands(); // Drains the command queue and applies every command (tick thread only).
 
-    TelemetrySnapshot m_state; // The current simulated telemetry state of the drone.
+    void applyCommand(const FleetCommand &cmd, int drone); // Applies one command to one drone.
+
+    MovementStrategy *strategyFor(int strategyType) const; // Registered strategy for a type, or nullptr.
+
+    QString m_id; // Unique identifier for this simulator instance.
+
+    FleetState m_fleet; // The current simulated telemetry state of every drone.
+
+    CommandQueue m_commands; // Commands pushed by other threads, drained at tick start.
+
+    FaultInjector m_faults; // Stochastic GPS/battery/sensor/link faults.
+
+    GpsNoiseModel m_gpsNoise; // Correlated position error applied on publication.
+
+    PublicationFilter m_filter; // Change-based suppression of unchanged drones.
+
+    std::vector<TelemetrySnapshot> m_published; // This tick's outgoing record of every running drone (noise and faults applied).
+
+    TelemetryBusWriter m_bus; // Shared-memory publication for other processes (closed unless opened).
+
+    UdpPublisher m_udp; // Network publication (closed unless opened).
+
+    ColumnarRecorder m_recorder; // Offline recording (closed unless opened).
 
     QDateTime m_lastUpdate; // Timestamp of the last simulation state update.
 
     QTimer *m_timer; // Timer responsible for driving the simulation ticks.
 
-    std::unique_ptr<MovementStrategy> m_strategy; // The current strategy controlling drone movement.
+    std::vector<std::unique_ptr<MovementStrategy>> m_strategies; // Strategy instances indexed by StrategyType.
+
+    std::vector<std::vector<int>> m_members; // Per-strategy drone lists, rebuilt every tick without reallocating.
 };
 
 #endif // DRONESIMULATOR_H
\ No newline at end of file
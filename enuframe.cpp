@@ -0,0 +1,42 @@
+#include "EnuFrame.h"
+
+#include <algorithm>
+
+#include <cmath>
+
+// WGS84 ellipsoid
+
+static constexpr double WGS84_A = 6378137.0;
+
+static constexpr double WGS84_E2 = 6.69437999014e-3;
+
+EnuFrame::EnuFrame(double originLatitude, double originLongitude)
+
+    : m_lat0(originLatitude),
+
+      m_lon0(originLongitude)
+
+{
+
+    const double phi = originLatitude * M_PI / 180.0;
+
+    const double s = std::sin(phi);
+
+    const double w = 1.0 - WGS84_E2 * s * s;
+
+    // meridional (M) and prime-vertical (N) radii of curvature
+
+    const double M = WGS84_A * (1.0 - WGS84_E2) / (w * std::sqrt(w));
+
+    const double N = WGS84_A / std::sqrt(w);
+
+    m_mPerDegLat = M * M_PI / 180.0;
+
+    // keep a tiny positive scale at the poles so the inverse stays finite
+
+    m_mPerDegLon = std::max(1e-6, N * std::cos(phi) * M_PI / 180.0);
+
+    m_degPerMNorth = 1.0 / m_mPerDegLat;
+
+    m_degPerMEast = 1.0 / m_mPerDegLon;
+}
@@ -0,0 +1,52 @@
+/******************************************************************************
+ * EnuFrame.h
+ * Author: Jatin Kumawat
+ * Date: 19-10-2026
+ *
+ * Description:
+ *   Local tangent plane (East-North-Up) around a geographic origin.
+ *
+ *   - Drones integrate in meters relative to a per-region origin instead of
+ *  raw degrees, which keeps full precision and needs no trigonometry
+ *   - Scale factors use the WGS84 radii of curvature at the origin and are
+ *  computed once, so converting to/from lat/lon is two multiply-adds
+ *   - Intended for regions of a few tens of kilometers around the origin
+ ******************************************************************************/
+
+#pragma once
+
+class EnuFrame
+{
+public:
+    EnuFrame(double originLatitude = 0.0, double originLongitude = 0.0); // Computes the scale factors once.
+
+    double originLatitude() const { return m_lat0; } // Degrees.
+
+    double originLongitude() const { return m_lon0; } // Degrees.
+
+    double metersPerDegreeLatitude() const { return m_mPerDegLat; } // North meters per degree of latitude.
+
+    double metersPerDegreeLongitude() const { return m_mPerDegLon; } // East meters per degree of longitude.
+
+    // ENU meters -> geodetic degrees.
+    void toGeodetic(double east, double north, double &latitude, double &longitude) const
+    {
+        latitude = m_lat0 + north * m_degPerMNorth;
+        longitude = m_lon0 + east * m_degPerMEast;
+    }
+
+    // Geodetic degrees -> ENU meters.
+    void toEnu(double latitude, double longitude, double &east, double &north) const
+    {
+        north = (latitude - m_lat0) * m_mPerDegLat;
+        east = (longitude - m_lon0) * m_mPerDegLon;
+    }
+
+private:
+    double m_lat0;         // Origin latitude (degrees).
+    double m_lon0;         // Origin longitude (degrees).
+    double m_mPerDegLat;   // Meridional scale at the origin.
+    double m_mPerDegLon;   // Parallel scale at the origin.
+    double m_degPerMNorth; // 1 / m_mPerDegLat.
+    double m_degPerMEast;  // 1 / m_mPerDegLon.
+};
@@ -0,0 +1,157 @@
+#include "FastRandom.h"
+
+#include <cmath>
+
+// Ziggurat tables for the standard normal (Marsaglia & Tsang, 128 layers,
+// layout as in Doornik's ZIGNOR). x[i] is the right edge of layer i and
+// ratio[i] = x[i+1] / x[i] is the fraction of the layer fully under the curve.
+
+static constexpr int ZIG_LAYERS = 128;
+
+static constexpr double ZIG_R = 3.442619855899; // start of the tail
+
+static constexpr double ZIG_V = 9.91256303526217e-3; // area of every layer
+
+namespace
+{
+
+    struct ZigguratTables
+    {
+
+        double x[ZIG_LAYERS + 1];
+
+        double ratio[ZIG_LAYERS];
+
+        ZigguratTables()
+        {
+
+            double f = std::exp(-0.5 * ZIG_R * ZIG_R);
+
+            x[0] = ZIG_V / f; // base layer includes the tail
+
+            x[1] = ZIG_R;
+
+            x[ZIG_LAYERS] = 0.0;
+
+            for (int i = 2; i < ZIG_LAYERS; ++i)
+            {
+
+                x[i] = std::sqrt(-2.0 * std::log(ZIG_V / x[i - 1] + f));
+
+                f = std::exp(-0.5 * x[i] * x[i]);
+            }
+
+            for (int i = 0; i < ZIG_LAYERS; ++i)
+                ratio[i] = x[i + 1] / x[i];
+        }
+    };
+
+    const ZigguratTables zig;
+}
+
+FastRandom::FastRandom(std::uint64_t seed)
+{
+
+    this->seed(seed);
+}
+
+void FastRandom::seed(std::uint64_t seed)
+{
+
+    // splitmix64 spreads any seed (even 0) over the whole state
+
+    for (std::uint64_t &word : m_s)
+    {
+
+        seed += 0x9E3779B97F4A7C15ull;
+
+        std::uint64_t z = seed;
+
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+
+        word = z ^ (z >> 31);
+    }
+}
+
+void FastRandom::fillUniform(double *out, std::size_t count)
+{
+
+    for (std::size_t i = 0; i < count; ++i)
+        out[i] = uniform();
+}
+
+double FastRandom::gaussian()
+{
+
+    // one 64-bit draw: top 53 bits give u in [-1, 1), bits 3..9 pick the layer
+    // (the lowest bits of xoshiro256+ are the weakest and are skipped)
+
+    const std::uint64_t r = next();
+
+    const double u = double(r >> 11) * 0x1.0p-52 - 1.0;
+
+    const int layer = int((r >> 3) & (ZIG_LAYERS - 1));
+
+    if (std::fabs(u) < zig.ratio[layer])
+        return u * zig.x[layer];
+
+    return gaussianSlow(u, layer);
+}
+
+double FastRandom::gaussianSlow(double u, int layer)
+{
+
+    for (;;)
+    {
+
+        if (layer == 0)
+        {
+
+            // tail beyond ZIG_R (Marsaglia's exponential rejection)
+
+            double x, y;
+
+            do
+            {
+
+                x = std::log(1.0 - uniform()) / ZIG_R;
+
+                y = std::log(1.0 - uniform());
+
+            } while (-2.0 * y < x * x);
+
+            return u < 0.0 ? x - ZIG_R : ZIG_R - x;
+        }
+
+        // wedge between the rectangle and the curve
+
+        const double x = u * zig.x[layer];
+
+        const double f0 = std::exp(-0.5 * (zig.x[layer] * zig.x[layer] - x * x));
+
+        const double f1 = std::exp(-0.5 * (zig.x[layer + 1] * zig.x[layer + 1] - x * x));
+
+        if (f1 + uniform() * (f0 - f1) < 1.0)
+            return x;
+
+        // rejected: draw a fresh point
+
+        const std::uint64_t r = next();
+
+        u = double(r >> 11) * 0x1.0p-52 - 1.0;
+
+        layer = int((r >> 3) & (ZIG_LAYERS - 1));
+
+        if (std::fabs(u) < zig.ratio[layer])
+            return u * zig.x[layer];
+    }
+}
+
+void FastRandom::fillGaussian(double *out, std::size_t count)
+{
+
+    for (std::size_t i = 0; i < count; ++i)
+        out[i] = gaussian();
+}
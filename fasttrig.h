@@ -0,0 +1,100 @@
+/******************************************************************************
+ * FastTrig.h
+ * Author: Jatin Kumawat
+ * Date: 19-10-2026
+ *
+ * Description:
+ *   Branch-light trigonometric approximations for the per-tick hot path.
+ *
+ *   - sinCos: Cody-Waite reduction to [-pi/4, pi/4] plus short polynomials,
+ *  absolute error below 2e-9 for |x| < 1e6 rad
+ *   - atan2: octant reduction plus an odd degree-11 polynomial, absolute
+ *  error below 2e-6 rad (about 1e-4 degree), ample for headings
+ *   - Header-only so calls inline into strategy loops
+ ******************************************************************************/
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+namespace FastTrig
+{
+    constexpr double PI = 3.14159265358979323846;
+    constexpr double DEG_TO_RAD = PI / 180.0;
+    constexpr double RAD_TO_DEG = 180.0 / PI;
+
+    // Computes sin(x) and cos(x) together (x in radians).
+    inline void sinCos(double x, double &s, double &c)
+    {
+        // x = k*(pi/2) + r, pi/2 split in two parts so r keeps full precision
+        constexpr double TWO_OVER_PI = 0.63661977236758134308;
+        constexpr double PIO2_HI = 1.57079632673412561417;
+        constexpr double PIO2_LO = 6.07710050650619224932e-11;
+
+        const double k = std::floor(x * TWO_OVER_PI + 0.5);
+        const double r = (x - k * PIO2_HI) - k * PIO2_LO;
+        const double r2 = r * r;
+
+        // Taylor polynomials, truncation error < r^11/11! on |r| <= pi/4
+        const double sr = r + r * r2 * (-1.0 / 6.0 + r2 * (1.0 / 120.0 + r2 * (-1.0 / 5040.0 + r2 * (1.0 / 362880.0))));
+        const double cr = 1.0 + r2 * (-0.5 + r2 * (1.0 / 24.0 + r2 * (-1.0 / 720.0 + r2 * (1.0 / 40320.0 + r2 * (-1.0 / 3628800.0)))));
+
+        switch (std::int64_t(k) & 3)
+        {
+        case 0:
+            s = sr;
+            c = cr;
+            break;
+        case 1:
+            s = cr;
+            c = -sr;
+            break;
+        case 2:
+            s = -sr;
+            c = -cr;
+            break;
+        default:
+            s = -cr;
+            c = sr;
+            break;
+        }
+    }
+
+    inline double sin(double x)
+    {
+        double s, c;
+        sinCos(x, s, c);
+        return s;
+    }
+
+    inline double cos(double x)
+    {
+        double s, c;
+        sinCos(x, s, c);
+        return c;
+    }
+
+    // atan2(y, x) in (-pi, pi]; returns 0 for (0, 0).
+    inline double atan2(double y, double x)
+    {
+        const double ax = std::fabs(x);
+        const double ay = std::fabs(y);
+        const double hi = ax > ay ? ax : ay;
+        const double lo = ax > ay ? ay : ax;
+
+        if (hi == 0.0)
+            return 0.0;
+
+        // atan on [0, 1]
+        const double a = lo / hi;
+        const double s = a * a;
+        double r = a * (0.99997726 + s * (-0.33262347 + s * (0.19354346 + s * (-0.11643287 + s * (0.05265332 + s * -0.01172120)))));
+
+        if (ay > ax)
+            r = 0.5 * PI - r;
+        if (x < 0.0)
+            r = PI - r;
+        return y < 0.0 ? -r : r;
+    }
+}
@@ -0,0 +1,416 @@
+#include "FaultInjector.h"
+
+#include <algorithm>
+
+#include <cmath>
+
+// converts an event rate into the probability of at least one event during dt
+
+static double perTick(double ratePerSec, double dt)
+{
+
+    return ratePerSec > 0.0 ? 1.0 - std::exp(-ratePerSec * dt) : 0.0;
+}
+
+// leaving a state whose mean duration is meanSec is a rate of 1 / meanSec
+
+static double endPerTick(double meanSec, double dt)
+{
+
+    return meanSec > 0.0 ? perTick(1.0 / meanSec, dt) : 1.0;
+}
+
+FaultProfile FaultProfile::none()
+{
+
+    FaultProfile p;
+
+    p.gpsDegradeRate = 0.0;
+
+    p.gpsDropoutRate = 0.0;
+
+    return p;
+}
+
+FaultProfile FaultProfile::nominal()
+{
+
+    return FaultProfile();
+}
+
+FaultProfile FaultProfile::stress()
+{
+
+    FaultProfile p;
+
+    p.gpsDegradeRate = 0.05;
+
+    p.gpsDropoutRate = 0.05;
+
+    p.gpsDropoutMeanSec = 8.0;
+
+    p.batterySagRate = 0.02;
+
+    p.cellFailureRate = 0.0005;
+
+    p.sensorBiasRate = 0.01;
+
+    p.sensorFreezeRate = 0.01;
+
+    p.linkLossRate = 0.02;
+
+    return p;
+}
+
+FaultInjector::FaultInjector(std::uint64_t seed) : m_rng(seed)
+{
+
+    m_profiles.push_back(FaultProfile::nominal());
+
+    m_tick.resize(1);
+
+    refreshEnabledChains();
+}
+
+void FaultInjector::setFleetProfile(const FaultProfile &profile)
+{
+
+    m_profiles[0] = profile;
+
+    refreshEnabledChains();
+}
+
+int FaultInjector::addProfile(const FaultProfile &profile)
+{
+
+    // profile indices are stored in a byte column
+
+    if (m_profiles.size() >= 256)
+        return 0;
+
+    m_profiles.push_back(profile);
+
+    m_tick.resize(m_profiles.size());
+
+    refreshEnabledChains();
+
+    return int(m_profiles.size()) - 1;
+}
+
+void FaultInjector::assignProfile(int drone, int profileIndex)
+{
+
+    if (drone < 0 || drone >= int(m_profile.size()))
+        return;
+
+    if (profileIndex < 0 || profileIndex >= int(m_profiles.size()))
+        return;
+
+    m_profile[drone] = std::uint8_t(profileIndex);
+}
+
+void FaultInjector::resize(int droneCount)
+{
+
+    m_profile.resize(droneCount, 0);
+
+    m_sag.resize(droneCount, 0);
+
+    m_cellFailed.resize(droneCount, 0);
+
+    m_drainDebt.resize(droneCount, 0.0);
+
+    m_biased.resize(droneCount, 0);
+
+    m_altitudeBias.resize(droneCount, 0.0);
+
+    m_frozen.resize(droneCount, 0);
+
+    m_frozenLatitude.resize(droneCount, 0.0);
+
+    m_frozenLongitude.resize(droneCount, 0.0);
+
+    m_frozenAltitude.resize(droneCount, 0.0);
+
+    m_linkLost.resize(droneCount, 0);
+
+    m_uniforms.resize(droneCount);
+}
+
+void FaultInjector::refreshEnabledChains()
+{
+
+    m_batteryEnabled = m_biasEnabled = m_freezeEnabled = m_linkEnabled = false;
+
+    for (const FaultProfile &p : m_profiles)
+    {
+
+        m_batteryEnabled |= p.batterySagRate > 0.0 || p.cellFailureRate > 0.0;
+
+        m_biasEnabled |= p.sensorBiasRate > 0.0;
+
+        m_freezeEnabled |= p.sensorFreezeRate > 0.0;
+
+        m_linkEnabled |= p.linkLossRate > 0.0;
+    }
+}
+
+void FaultInjector::prepareTick(double dt)
+{
+
+    // exp() once per profile per tick, never per drone
+
+    for (std::size_t k = 0; k < m_profiles.size(); ++k)
+    {
+
+        const FaultProfile &p = m_profiles[k];
+
+        TickProbabilities &t = m_tick[k];
+
+        t.gpsDegrade = perTick(p.gpsDegradeRate, dt);
+
+        t.gpsRecover = perTick(p.gpsRecoverRate, dt);
+
+        t.gpsDropout = perTick(p.gpsDropoutRate, dt);
+
+        t.gpsReacquire = endPerTick(p.gpsDropoutMeanSec, dt);
+
+        t.sagStart = perTick(p.batterySagRate, dt);
+
+        t.sagEnd = endPerTick(p.batterySagMeanSec, dt);
+
+        t.sagDrain = p.batterySagDrainPctPerSec * dt;
+
+        t.cellFailure = perTick(p.cellFailureRate, dt);
+
+        t.cellDrain = p.cellFailureDrainPctPerSec * dt;
+
+        t.biasStart = perTick(p.sensorBiasRate, dt);
+
+        t.biasEnd = endPerTick(p.sensorBiasMeanSec, dt);
+
+        t.freezeStart = perTick(p.sensorFreezeRate, dt);
+
+        t.freezeEnd = endPerTick(p.sensorFreezeMeanSec, dt);
+
+        t.linkLoss = perTick(p.linkLossRate, dt);
+
+        t.linkRestore = endPerTick(p.linkLossMeanSec, dt);
+    }
+}
+
+void FaultInjector::step(FleetState &fleet, double dt)
+{
+
+    const int n = std::min(fleet.size(), int(m_profile.size()));
+
+    if (n == 0 || dt <= 0.0)
+        return;
+
+    prepareTick(dt);
+
+    double *u = m_uniforms.data();
+
+    using Fix = TelemetrySnapshot::GpsFix;
+
+    // --- GPS fix chain ---
+
+    m_rng.fillUniform(u, n);
+
+    for (int i = 0; i < n; ++i)
+    {
+
+        // paused drones are frozen: no chain advances (the draw is still consumed, so others are unaffected)
+
+        if (fleet.paused[i])
+            continue;
+
+        const TickProbabilities &t = m_tick[m_profile[i]];
+
+        Fix fix = fleet.gpsFix[i];
+
+        if (fleet.failure[i])
+        {
+
+            // operator-injected failure pins the fix at NoFix
+
+            fix = Fix::NoFix;
+        }
+        else if (fix == Fix::NoFix)
+        {
+
+            fix = u[i] < t.gpsReacquire ? Fix::Fix3D : Fix::NoFix;
+        }
+        else if (u[i] < t.gpsDropout)
+        {
+
+            fix = Fix::NoFix;
+        }
+        else if (fix == Fix::Fix3D)
+        {
+
+            fix = u[i] < t.gpsDropout + t.gpsDegrade ? Fix::Fix2D : Fix::Fix3D;
+        }
+        else
+        {
+
+            fix = u[i] < t.gpsDropout + t.gpsRecover ? Fix::Fix3D : Fix::Fix2D;
+        }
+
+        fleet.gpsFix[i] = fix;
+    }
+
+    // --- Battery sag and cell failure ---
+
+    if (m_batteryEnabled)
+    {
+
+        m_rng.fillUniform(u, n);
+
+        for (int i = 0; i < n; ++i)
+        {
+
+            if (fleet.paused[i])
+                continue;
+
+            const TickProbabilities &t = m_tick[m_profile[i]];
+
+            // one draw drives both chains: low values toggle sag, high values fail a cell
+
+            const bool toggleSag = u[i] < (m_sag[i] ? t.sagEnd : t.sagStart);
+
+            const bool failCell = !m_cellFailed[i] && u[i] >= 1.0 - t.cellFailure;
+
+            m_sag[i] ^= toggleSag ? 1 : 0;
+
+            if (failCell)
+            {
+
+                m_cellFailed[i] = 1;
+
+                const int cells = std::max(1, m_profiles[m_profile[i]].cellCount);
+
+                fleet.battery[i] -= fleet.battery[i] / cells;
+            }
+
+            m_drainDebt[i] += (m_sag[i] ? t.sagDrain : 0.0) + (m_cellFailed[i] ? t.cellDrain : 0.0);
+
+            const int whole = int(m_drainDebt[i]);
+
+            m_drainDebt[i] -= whole;
+
+            fleet.battery[i] = std::max(0, fleet.battery[i] - whole);
+        }
+    }
+
+    // --- Altitude sensor bias ---
+
+    if (m_biasEnabled)
+    {
+
+        m_rng.fillUniform(u, n);
+
+        for (int i = 0; i < n; ++i)
+        {
+
+            if (fleet.paused[i])
+                continue;
+
+            const TickProbabilities &t = m_tick[m_profile[i]];
+
+            if (m_biased[i])
+            {
+
+                if (u[i] < t.biasEnd)
+                {
+
+                    m_biased[i] = 0;
+
+                    m_altitudeBias[i] = 0.0;
+                }
+            }
+            else if (u[i] < t.biasStart)
+            {
+
+                // reuse the draw: u / p is again uniform in [0, 1)
+
+                const double maxBias = m_profiles[m_profile[i]].sensorBiasMaxMeters;
+
+                m_biased[i] = 1;
+
+                m_altitudeBias[i] = (2.0 * u[i] / t.biasStart - 1.0) * maxBias;
+            }
+        }
+    }
+
+    // --- Sensor freeze ---
+
+    if (m_freezeEnabled)
+    {
+
+        m_rng.fillUniform(u, n);
+
+        for (int i = 0; i < n; ++i)
+        {
+
+            if (fleet.paused[i])
+                continue;
+
+            const TickProbabilities &t = m_tick[m_profile[i]];
+
+            if (m_frozen[i])
+            {
+
+                m_frozen[i] = u[i] < t.freezeEnd ? 0 : 1;
+            }
+            else if (u[i] < t.freezeStart)
+            {
+
+                m_frozen[i] = 1;
+
+                // geodetic conversion only at fault onset
+
+                fleet.geodetic(i, m_frozenLatitude[i], m_frozenLongitude[i]);
+
+                m_frozenAltitude[i] = fleet.altitude[i];
+            }
+        }
+    }
+
+    // --- Link loss ---
+
+    if (m_linkEnabled)
+    {
+
+        m_rng.fillUniform(u, n);
+
+        for (int i = 0; i < n; ++i)
+        {
+
+            if (fleet.paused[i])
+                continue;
+
+            const TickProbabilities &t = m_tick[m_profile[i]];
+
+            const double p = m_linkLost[i] ? t.linkRestore : t.linkLoss;
+
+            m_linkLost[i] ^= u[i] < p ? 1 : 0;
+        }
+    }
+}
+
+void FaultInjector::applySensorFaults(int i, TelemetrySnapshot &snap) const
+{
+
+    if (m_frozen[i])
+    {
+
+        snap.latitude = m_frozenLatitude[i];
+
+        snap.longitude = m_frozenLongitude[i];
+
+        snap.altitude = m_frozenAltitude[i];
+    }
+
+    snap.altitude += m_altitudeBias[i];
+}
@@ -0,0 +1,134 @@
+/******************************************************************************
+ * FaultInjector.h
+ * Author: Jatin Kumawat
+ * Date: 19-10-2026
+ *
+ * Description:
+ *   Stochastic fault-injection engine for the simulated fleet.
+ *
+ *   - Every fault is a small Markov chain (GPS 3D/2D/NoFix, battery sag,
+ *  cell failure, sensor bias, sensor freeze, link loss)
+ *   - Transition rates come from FaultProfiles, one per fleet or per drone
+ *   - Chains are evaluated in batch over columnar state, one pass per fault,
+ *  with a block of uniforms drawn per pass; unused faults cost nothing
+ ******************************************************************************/
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include "FleetState.h"
+#include "FastRandom.h"
+
+// Transition rates and magnitudes of every fault. Rates are events per second;
+// "MeanSec" values are mean durations of a fault once it started.
+struct FaultProfile
+{
+    // GPS fix chain: Fix3D <-> Fix2D, either -> NoFix -> Fix3D.
+    double gpsDegradeRate = 0.01;   // Fix3D -> Fix2D.
+    double gpsRecoverRate = 0.2;    // Fix2D -> Fix3D.
+    double gpsDropoutRate = 0.02;   // Fix3D/Fix2D -> NoFix.
+    double gpsDropoutMeanSec = 5.0; // Mean NoFix duration.
+
+    // Battery voltage sag (temporary extra drain).
+    double batterySagRate = 0.0;
+    double batterySagMeanSec = 10.0;
+    double batterySagDrainPctPerSec = 0.5;
+
+    // Cell failure (permanent): loses 1/cellCount of the remaining charge, then drains faster.
+    double cellFailureRate = 0.0;
+    int cellCount = 4;
+    double cellFailureDrainPctPerSec = 0.2;
+
+    // Altitude sensor bias: constant offset drawn in [-max, +max] meters.
+    double sensorBiasRate = 0.0;
+    double sensorBiasMeanSec = 30.0;
+    double sensorBiasMaxMeters = 5.0;
+
+    // Sensor freeze: reported position stops updating.
+    double sensorFreezeRate = 0.0;
+    double sensorFreezeMeanSec = 3.0;
+
+    // Link loss: telemetry is not published.
+    double linkLossRate = 0.0;
+    double linkLossMeanSec = 2.0;
+
+    static FaultProfile none();    // No faults at all.
+    static FaultProfile nominal(); // Occasional GPS degradation only (default).
+    static FaultProfile stress();  // Every fault enabled with high rates.
+};
+
+class FaultInjector
+{
+public:
+    explicit FaultInjector(std::uint64_t seed = 0x5EEDull); // Profile 0 is FaultProfile::nominal().
+
+    // Replaces the fleet-wide profile (index 0).
+    void setFleetProfile(const FaultProfile &profile);
+
+    // Registers an additional profile and returns its index. Call before start().
+    int addProfile(const FaultProfile &profile);
+
+    // Makes drone use profile index. Invalid indices are ignored. No allocation.
+    void assignProfile(int drone, int profileIndex);
+
+    int profileCount() const { return int(m_profiles.size()); } // Number of registered profiles.
+
+    // Grows the per-drone columns to match the fleet. Call whenever drones are added.
+    void resize(int droneCount);
+
+    // Advances every fault chain by dt seconds and applies physical effects
+    // (GPS fix, battery) to fleet. Paused drones are skipped: their chains,
+    // fix and battery stay as they were. Tick thread only.
+    void step(FleetState &fleet, double dt);
+
+    // Applies sensor faults (freeze, bias) to the published copy of drone i.
+    void applySensorFaults(int i, TelemetrySnapshot &snap) const;
+
+    bool linkLost(int i) const { return m_linkLost[i] != 0; } // True while drone i cannot publish.
+
+    const std::uint8_t *linkLostFlags() const { return m_linkLost.data(); } // linkLost() of every drone, for batch passes.
+
+private:
+    // Per-tick transition probabilities derived from a profile: p = 1 - exp(-rate * dt).
+    struct TickProbabilities
+    {
+        double gpsDegrade, gpsRecover, gpsDropout, gpsReacquire;
+        double sagStart, sagEnd, sagDrain;
+        double cellFailure, cellDrain;
+        double biasStart, biasEnd;
+        double freezeStart, freezeEnd;
+        double linkLoss, linkRestore;
+    };
+
+    void prepareTick(double dt); // Fills m_tick for every profile.
+
+    void refreshEnabledChains(); // Recomputes which chains any profile can trigger.
+
+    FastRandom m_rng; // Generator feeding every chain.
+
+    std::vector<FaultProfile> m_profiles; // Registered profiles, 0 = fleet default.
+
+    std::vector<TickProbabilities> m_tick; // Per-profile probabilities for the current tick.
+
+    std::vector<double> m_uniforms; // Scratch block of uniforms, one per drone.
+
+    // Enabled-chain flags: chains no profile can trigger are skipped entirely.
+    bool m_batteryEnabled = false;
+    bool m_biasEnabled = false;
+    bool m_freezeEnabled = false;
+    bool m_linkEnabled = false;
+
+    // --- Per-drone fault columns ---
+    std::vector<std::uint8_t> m_profile;    // Profile index.
+    std::vector<std::uint8_t> m_sag;        // 1 while the battery sags.
+    std::vector<std::uint8_t> m_cellFailed; // 1 once a cell has failed.
+    std::vector<double> m_drainDebt;        // Fractional battery percent not yet removed.
+    std::vector<std::uint8_t> m_biased;     // 1 while the altitude bias is active.
+    std::vector<double> m_altitudeBias;     // Current altitude bias (meters).
+    std::vector<std::uint8_t> m_frozen;     // 1 while sensors are frozen.
+    std::vector<double> m_frozenLatitude;   // Position held while frozen.
+    std::vector<double> m_frozenLongitude;
+    std::vector<double> m_frozenAltitude;
+    std::vector<std::uint8_t> m_linkLost;   // 1 while the link is down.
+};
@@ -0,0 +1,93 @@
+/******************************************************************************
+ * FleetCommand.h
+ * Author: Jatin Kumawat
+ * Date: 19-10-2026
+ *
+ * Description:
+ *   Typed control command sent from the UI (or any other thread) to the
+ *   simulator.
+ *
+ *   - Strategy switches, failure injection, fault profiles, speed/altitude
+ *  overrides and pause/resume
+ *   - Targets a single drone, a drone group or the whole fleet
+ *   - Plain value type so it can be copied through the lock-free CommandQueue
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+// A single control command. Built through the static helpers below.
+struct FleetCommand
+{
+    // What the command does.
+    enum class Type : std::uint8_t
+    {
+        SetStrategy = 0,      // value = StrategyType::Type to switch to.
+        SetFailureMode = 1,   // value != 0 enables failure injection, 0 disables it.
+        OverrideSpeed = 2,    // value = forced ground speed (m/s).
+        OverrideAltitude = 3, // value = forced altitude (meters).
+        ClearOverrides = 4,   // Drops any speed/altitude override.
+        Pause = 5,            // Freezes the targeted drones.
+        Resume = 6,           // Unfreezes the targeted drones.
+        SetFaultProfile = 7   // value = FaultInjector profile index.
+    };
+
+    // Which drones the command applies to.
+    enum class Scope : std::uint8_t
+    {
+        Drone = 0, // target = drone index inside the fleet.
+        Group = 1, // target = group id.
+        Fleet = 2  // target is ignored, every drone is affected.
+    };
+
+    Type type = Type::Pause;    // Command kind.
+    Scope scope = Scope::Fleet; // Addressing mode.
+    int target = 0;             // Drone index or group id, depending on scope.
+    double value = 0.0;         // Command argument, meaning depends on type.
+
+    // Helpers creating fully initialized commands.
+    static FleetCommand setStrategy(int strategyType, Scope scope = Scope::Fleet, int target = 0)
+    {
+        return {Type::SetStrategy, scope, target, double(strategyType)};
+    }
+
+    static FleetCommand setFailureMode(bool enabled, Scope scope = Scope::Fleet, int target = 0)
+    {
+        return {Type::SetFailureMode, scope, target, enabled ? 1.0 : 0.0};
+    }
+
+    static FleetCommand overrideSpeed(double speed, Scope scope = Scope::Fleet, int target = 0)
+    {
+        return {Type::OverrideSpeed, scope, target, speed};
+    }
+
+    static FleetCommand overrideAltitude(double altitude, Scope scope = Scope::Fleet, int target = 0)
+    {
+        return {Type::OverrideAltitude, scope, target, altitude};
+    }
+
+    static FleetCommand clearOverrides(Scope scope = Scope::Fleet, int target = 0)
+    {
+        return {Type::ClearOverrides, scope, target, 0.0};
+    }
+
+    static FleetCommand setFaultProfile(int profileIndex, Scope scope = Scope::Fleet, int target = 0)
+    {
+        return {Type::SetFaultProfile, scope, target, double(profileIndex)};
+    }
+
+    static FleetCommand pause(Scope scope = Scope::Fleet, int target = 0)
+    {
+        return {Type::Pause, scope, target, 0.0};
+    }
+
+    static FleetCommand resume(Scope scope = Scope::Fleet, int target = 0)
+    {
+        return {Type::Resume, scope, target, 0.0};
+    }
+};
+
+// Commands are copied byte-wise through the ring buffer.
+static_assert(std::is_trivially_copyable<FleetCommand>::value, "FleetCommand must stay trivially copyable");
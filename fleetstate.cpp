@@ -0,0 +1,140 @@
+#include "FleetState.h"
+
+#include <limits>
+
+int FleetState::add(const QString &droneId, int groupId, int strategyType)
+{
+
+    const TelemetrySnapshot defaults;
+
+    id.push_back(droneId);
+
+    east.push_back(0.0);
+
+    north.push_back(0.0);
+
+    region.push_back(0);
+
+    altitude.push_back(defaults.altitude);
+
+    heading.push_back(defaults.heading);
+
+    speed.push_back(defaults.speed);
+
+    battery.push_back(defaults.battery);
+
+    gpsFix.push_back(defaults.gpsFix);
+
+    timestampMs.push_back(defaults.timestampMs);
+
+    group.push_back(groupId);
+
+    strategy.push_back(strategyType);
+
+    paused.push_back(0);
+
+    failure.push_back(0);
+
+    speedOverride.push_back(std::numeric_limits<double>::quiet_NaN());
+
+    altitudeOverride.push_back(std::numeric_limits<double>::quiet_NaN());
+
+    return size() - 1;
+}
+
+int FleetState::addRegion(double originLatitude, double originLongitude)
+{
+
+    regions.emplace_back(originLatitude, originLongitude);
+
+    return int(regions.size()) - 1;
+}
+
+void FleetState::place(int i, double latitude, double longitude, int regionIndex)
+{
+
+    if (regionIndex < 0 || regionIndex >= int(regions.size()))
+        regionIndex = 0;
+
+    region[i] = regionIndex;
+
+    regions[regionIndex].toEnu(latitude, longitude, east[i], north[i]);
+}
+
+void FleetState::reserve(int count)
+{
+
+    id.reserve(count);
+
+    east.reserve(count);
+
+    north.reserve(count);
+
+    region.reserve(count);
+
+    altitude.reserve(count);
+
+    heading.reserve(count);
+
+    speed.reserve(count);
+
+    battery.reserve(count);
+
+    gpsFix.reserve(count);
+
+    timestampMs.reserve(count);
+
+    group.reserve(count);
+
+    strategy.reserve(count);
+
+    paused.reserve(count);
+
+    failure.reserve(count);
+
+    speedOverride.reserve(count);
+
+    altitudeOverride.reserve(count);
+}
+
+TelemetrySnapshot FleetState::snapshot(int i) const
+{
+
+    TelemetrySnapshot snap;
+
+    snap.id = id[i];
+
+    geodetic(i, snap.latitude, snap.longitude);
+
+    snap.altitude = altitude[i];
+
+    snap.heading = heading[i];
+
+    snap.speed = speed[i];
+
+    snap.battery = battery[i];
+
+    snap.gpsFix = gpsFix[i];
+
+    snap.timestampMs = timestampMs[i];
+
+    return snap;
+}
+
+void FleetState::store(int i, const TelemetrySnapshot &snap)
+{
+
+    regions[region[i]].toEnu(snap.latitude, snap.longitude, east[i], north[i]);
+
+    altitude[i] = snap.altitude;
+
+    heading[i] = snap.heading;
+
+    speed[i] = snap.speed;
+
+    battery[i] = snap.battery;
+
+    gpsFix[i] = snap.gpsFix;
+
+    timestampMs[i] = snap.timestampMs;
+}
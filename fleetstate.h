@@ -0,0 +1,75 @@
+/******************************************************************************
+ * FleetState.h
+ * Author: Jatin Kumawat
+ * Date: 19-10-2026
+ *
+ * Description:
+ *   Columnar (structure-of-arrays) state of every drone owned by a simulator.
+ *
+ *   - One contiguous array per telemetry field, indexed by drone
+ *   - Position is kept in local ENU meters relative to a per-region origin
+ *  (EnuFrame); lat/lon are derived only when a consumer asks for them
+ *   - Per-drone control columns written by FleetCommand (strategy, group,
+ *  pause, failure mode, overrides)
+ *   - Converts to/from TelemetrySnapshot for per-drone strategies and the UI
+ ******************************************************************************/
+
+#pragma once
+
+#include <QString>
+#include <cstdint>
+#include <vector>
+#include "TelemetryTypes.h"
+#include "EnuFrame.h"
+
+struct FleetState
+{
+    // --- Telemetry columns ---
+    std::vector<QString> id;                          // Drone identifier (cold, only read when publishing).
+    std::vector<double> east;                         // Meters east of the region origin.
+    std::vector<double> north;                        // Meters north of the region origin.
+    std::vector<double> altitude;                     // Meters.
+    std::vector<double> heading;                      // Degrees 0-360.
+    std::vector<double> speed;                        // m/s.
+    std::vector<int> battery;                         // Percent 0-100.
+    std::vector<TelemetrySnapshot::GpsFix> gpsFix;    // Current fix quality.
+    std::vector<qint64> timestampMs;                  // Time of the last update.
+
+    // --- Local frames ---
+    std::vector<EnuFrame> regions{EnuFrame()}; // Region origins; region 0 is (0, 0) until changed.
+    std::vector<int> region;                   // Region whose origin the drone's east/north refer to.
+
+    // --- Control columns (written by FleetCommand) ---
+    std::vector<int> group;                // Group id used for group-scoped commands.
+    std::vector<int> strategy;             // StrategyType driving this drone.
+    std::vector<std::uint8_t> paused;      // 1 = frozen, skipped by the tick.
+    std::vector<std::uint8_t> failure;     // 1 = failure injection enabled.
+    std::vector<double> speedOverride;     // Forced speed, NaN when not overridden.
+    std::vector<double> altitudeOverride;  // Forced altitude, NaN when not overridden.
+
+    int size() const { return int(east.size()); } // Number of drones.
+
+    // Appends a drone at the origin of region 0 with default telemetry and returns its index.
+    int add(const QString &droneId, int groupId, int strategyType);
+
+    // Registers a region origin and returns its index.
+    int addRegion(double originLatitude, double originLongitude);
+
+    // Moves drone i to a geodetic position, expressed in region regionIndex.
+    void place(int i, double latitude, double longitude, int regionIndex = 0);
+
+    // Geodetic position of drone i (two multiply-adds, no trigonometry).
+    void geodetic(int i, double &latitude, double &longitude) const
+    {
+        regions[region[i]].toGeodetic(east[i], north[i], latitude, longitude);
+    }
+
+    // Pre-allocates every column for the given fleet size.
+    void reserve(int count);
+
+    // Gathers the row of drone i into a snapshot (lat/lon derived from ENU).
+    TelemetrySnapshot snapshot(int i) const;
+
+    // Scatters a snapshot back into row i (lat/lon converted to ENU; the id column is left untouched).
+    void store(int i, const TelemetrySnapshot &snap);
+};
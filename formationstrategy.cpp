@@ -0,0 +1,385 @@
+#include "FormationStrategy.h"
+
+#include <algorithm>
+
+#include <cmath>
+
+#include "FastTrig.h"
+
+FormationStrategy::FormationStrategy(const FormationConfig &config) : m_config(config)
+{
+
+    m_config.columns = std::max(1, m_config.columns);
+}
+
+TelemetrySnapshot FormationStrategy::step(const TelemetrySnapshot &current, double dt)
+{
+
+    // alone it is its own leader: hold the heading at cruise speed, in a one-drone fleet built once
+
+    if (m_single.size() == 0)
+    {
+
+        m_single.add(current.id, 0, 0);
+
+        m_singleMembers.assign(1, 0);
+    }
+
+    m_single.store(0, current);
+
+    stepBatch(m_single, m_singleMembers, dt);
+
+    TelemetrySnapshot next = m_single.snapshot(0);
+
+    next.id = current.id;
+
+    return next;
+}
+
+void FormationStrategy::setLeader(int group, int drone)
+{
+
+    if (group < 0)
+        return;
+
+    if (group >= int(m_explicitLeader.size()))
+        m_explicitLeader.resize(group + 1, -1);
+
+    m_explicitLeader[group] = drone;
+}
+
+void FormationStrategy::slotOffset(int rank, double &forward, double &right) const
+{
+
+    // row 1 starts one spacing behind the leader, columns centered on its track
+
+    const int row = rank / m_config.columns;
+
+    const int column = rank % m_config.columns;
+
+    forward = -(row + 1) * m_config.spacing;
+
+    right = (column - 0.5 * (m_config.columns - 1)) * m_config.spacing;
+}
+
+void FormationStrategy::resolveLeaders(const FleetState &fleet)
+{
+
+    const int count = fleet.size();
+
+    int groups = int(m_explicitLeader.size());
+
+    for (int i = 0; i < count; ++i)
+        groups = std::max(groups, fleet.group[i] + 1);
+
+    m_groupLeader.assign(groups, -1);
+
+    // default: lowest-indexed drone of the group
+
+    for (int i = 0; i < count; ++i)
+    {
+
+        const int g = fleet.group[i];
+
+        if (g >= 0 && m_groupLeader[g] < 0)
+            m_groupLeader[g] = i;
+    }
+
+    // an explicit leader counts only while it belongs to the group (drones can be regrouped)
+
+    for (int g = 0; g < int(m_explicitLeader.size()); ++g)
+    {
+
+        const int leader = m_explicitLeader[g];
+
+        if (leader >= 0 && leader < count && fleet.group[leader] == g)
+            m_groupLeader[g] = leader;
+    }
+}
+
+void FormationStrategy::stepBatch(FleetState &fleet, const std::vector<int> &members, double dt)
+{
+
+    const int n = int(members.size());
+
+    if (n == 0)
+        return;
+
+    resolveLeaders(fleet);
+
+    // common frame: region 0 (groups may span regions)
+
+    const int regions = int(fleet.regions.size());
+
+    m_regionEast.resize(regions);
+
+    m_regionNorth.resize(regions);
+
+    for (int r = 0; r < regions; ++r)
+        fleet.regions[0].toEnu(fleet.regions[r].originLatitude(), fleet.regions[r].originLongitude(), m_regionEast[r], m_regionNorth[r]);
+
+    // --- read buffer: leaders ---
+
+    const int groups = int(m_groupLeader.size());
+
+    m_leaderEast.resize(groups);
+
+    m_leaderNorth.resize(groups);
+
+    m_leaderAlt.resize(groups);
+
+    m_leaderVe.resize(groups);
+
+    m_leaderVn.resize(groups);
+
+    m_leaderSin.resize(groups);
+
+    m_leaderCos.resize(groups);
+
+    for (int g = 0; g < groups; ++g)
+    {
+
+        const int L = m_groupLeader[g];
+
+        if (L < 0)
+            continue;
+
+        double s, c;
+
+        FastTrig::sinCos(fleet.heading[L] * FastTrig::DEG_TO_RAD, s, c);
+
+        m_leaderEast[g] = fleet.east[L] + m_regionEast[fleet.region[L]];
+
+        m_leaderNorth[g] = fleet.north[L] + m_regionNorth[fleet.region[L]];
+
+        m_leaderAlt[g] = fleet.altitude[L];
+
+        m_leaderVe[g] = s * fleet.speed[L];
+
+        m_leaderVn[g] = c * fleet.speed[L];
+
+        m_leaderSin[g] = s;
+
+        m_leaderCos[g] = c;
+    }
+
+    // --- read buffer: members, and their slots (ranked by drone index, not by member order) ---
+
+    // capacity for the whole fleet: batches grow when groups switch strategy, the tick must not allocate
+
+    const std::size_t capacity = std::size_t(fleet.size());
+
+    for (std::vector<double> *v : {&m_readEast, &m_readNorth, &m_readAlt, &m_writeEast, &m_writeNorth, &m_writeAlt, &m_writeSpeed, &m_writeHeading})
+        v->reserve(capacity);
+
+    for (std::vector<int> *v : {&m_group, &m_rank, &m_slotMember})
+        v->reserve(capacity);
+
+    m_group.resize(n);
+
+    m_rank.resize(n);
+
+    m_readEast.resize(n);
+
+    m_readNorth.resize(n);
+
+    m_readAlt.resize(n);
+
+    m_writeEast.resize(n);
+
+    m_writeNorth.resize(n);
+
+    m_writeAlt.resize(n);
+
+    m_writeSpeed.resize(n);
+
+    m_writeHeading.resize(n);
+
+    // followers bucketed by group in one flat list: group g holds [m_slotStart[g], m_slotStart[g + 1])
+
+    m_slotStart.assign(groups + 1, 0);
+
+    for (int k = 0; k < n; ++k)
+    {
+
+        const int i = members[k];
+
+        const int g = fleet.group[i];
+
+        m_group[k] = g;
+
+        m_readEast[k] = fleet.east[i] + m_regionEast[fleet.region[i]];
+
+        m_readNorth[k] = fleet.north[i] + m_regionNorth[fleet.region[i]];
+
+        m_readAlt[k] = fleet.altitude[i];
+
+        // no group, or the leader itself: flies ahead on its own
+
+        m_rank[k] = -1;
+
+        if (g >= 0 && m_groupLeader[g] != i)
+            ++m_slotStart[g + 1];
+    }
+
+    for (int g = 0; g < groups; ++g)
+        m_slotStart[g + 1] += m_slotStart[g];
+
+    m_slotMember.resize(m_slotStart[groups]);
+
+    // fill with m_slotStart[g] as the cursor, then shift the starts back into place
+
+    for (int k = 0; k < n; ++k)
+    {
+
+        const int g = m_group[k];
+
+        if (g >= 0 && m_groupLeader[g] != members[k])
+            m_slotMember[m_slotStart[g]++] = k;
+    }
+
+    for (int g = groups; g > 0; --g)
+        m_slotStart[g] = m_slotStart[g - 1];
+
+    m_slotStart[0] = 0;
+
+    for (int g = 0; g < groups; ++g)
+    {
+
+        int *ranked = m_slotMember.data() + m_slotStart[g];
+
+        const int size = m_slotStart[g + 1] - m_slotStart[g];
+
+        std::sort(ranked, ranked + size, [&members](int a, int b) { return members[a] < members[b]; });
+
+        for (int r = 0; r < size; ++r)
+            m_rank[ranked[r]] = r;
+    }
+
+    // --- solve: reads only the read buffers, writes only the write buffers ---
+
+    const double sep = m_config.separation;
+
+    for (int k = 0; k < n; ++k)
+    {
+
+        const int i = members[k];
+
+        const int rank = m_rank[k];
+
+        double ve, vn, climb = 0.0;
+
+        if (rank < 0)
+        {
+
+            double s, c;
+
+            FastTrig::sinCos(fleet.heading[i] * FastTrig::DEG_TO_RAD, s, c);
+
+            ve = s * m_config.leaderSpeed;
+
+            vn = c * m_config.leaderSpeed;
+        }
+        else
+        {
+
+            const int g = m_group[k];
+
+            double forward, right;
+
+            slotOffset(rank, forward, right);
+
+            // body frame -> ENU with the leader's heading (forward = (sin, cos), right = (cos, -sin))
+
+            const double s = m_leaderSin[g], c = m_leaderCos[g];
+
+            const double targetEast = m_leaderEast[g] + forward * s + right * c;
+
+            const double targetNorth = m_leaderNorth[g] + forward * c - right * s;
+
+            ve = m_leaderVe[g] + m_config.positionGain * (targetEast - m_readEast[k]);
+
+            vn = m_leaderVn[g] + m_config.positionGain * (targetNorth - m_readNorth[k]);
+
+            // grid neighbors: left/right in the row, ahead/behind in the column
+
+            const int *ranked = m_slotMember.data() + m_slotStart[g];
+
+            const int size = m_slotStart[g + 1] - m_slotStart[g];
+
+            const int neighbors[4] = {rank % m_config.columns ? rank - 1 : -1,
+                                      (rank + 1) % m_config.columns ? rank + 1 : -1,
+                                      rank - m_config.columns,
+                                      rank + m_config.columns};
+
+            for (int r : neighbors)
+            {
+
+                if (r < 0 || r >= size)
+                    continue;
+
+                const double de = m_readEast[k] - m_readEast[ranked[r]];
+
+                const double dn = m_readNorth[k] - m_readNorth[ranked[r]];
+
+                const double d = std::sqrt(de * de + dn * dn);
+
+                if (d < sep && d > 1e-9)
+                {
+
+                    const double push = m_config.separationGain * (sep - d) / d;
+
+                    ve += de * push;
+
+                    vn += dn * push;
+                }
+            }
+
+            const double speed = std::sqrt(ve * ve + vn * vn);
+
+            if (speed > m_config.maxSpeed)
+            {
+
+                ve *= m_config.maxSpeed / speed;
+
+                vn *= m_config.maxSpeed / speed;
+            }
+
+            climb = std::clamp(m_config.climbGain * (m_leaderAlt[g] - m_readAlt[k]), -m_config.maxClimbRate, m_config.maxClimbRate);
+        }
+
+        const double speed = std::sqrt(ve * ve + vn * vn);
+
+        m_writeEast[k] = m_readEast[k] + ve * dt;
+
+        m_writeNorth[k] = m_readNorth[k] + vn * dt;
+
+        m_writeAlt[k] = m_readAlt[k] + climb * dt;
+
+        m_writeSpeed[k] = speed;
+
+        // a follower holding still keeps its heading
+
+        const double heading = FastTrig::atan2(ve, vn) * FastTrig::RAD_TO_DEG;
+
+        m_writeHeading[k] = speed > 1e-3 ? (heading < 0.0 ? heading + 360.0 : heading) : fleet.heading[i];
+    }
+
+    // --- commit the write buffer ---
+
+    for (int k = 0; k < n; ++k)
+    {
+
+        const int i = members[k];
+
+        fleet.east[i] = m_writeEast[k] - m_regionEast[fleet.region[i]];
+
+        fleet.north[i] = m_writeNorth[k] - m_regionNorth[fleet.region[i]];
+
+        fleet.altitude[i] = m_writeAlt[k];
+
+        fleet.speed[i] = m_writeSpeed[k];
+
+        fleet.heading[i] = m_writeHeading[k];
+    }
+}
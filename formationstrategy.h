@@ -0,0 +1,84 @@
+/******************************************************************************
+ * FormationStrategy.h
+ * Author: Jatin Kumawat
+ * Date: 19-10-2026
+ *
+ * Description:
+ *   Leader-follower formation flight for swarm scenarios.
+ *
+ *   - Every group (FleetState::group) flies a grid behind its leader: by
+ *  default the group's lowest-indexed drone, whatever strategy flies it
+ *   - Followers steer toward their slot (rotated with the leader's heading)
+ *  and push away from their grid neighbors when they get too close
+ *   - Solved in batch: leader and follower state is copied into read
+ *  columns first, then all followers are solved in one pass that only
+ *  reads those columns and writes separate output columns, so the result
+ *  does not depend on member order (or on how the pass would be split
+ *  between threads)
+ *   - A leader flown by this strategy itself holds its heading at cruise speed
+ ******************************************************************************/
+
+#pragma once
+
+#include <vector>
+#include "MovementStrategy.h"
+
+// Grid geometry and follower control parameters.
+struct FormationConfig
+{
+    int columns = 10;             // Slots per grid row (rows extend behind the leader).
+    double spacing = 5.0;         // Meters between neighboring slots, and from the leader to row 1.
+    double leaderSpeed = 6.0;     // Cruise speed of a leader flown by this strategy (m/s).
+    double positionGain = 0.8;    // Velocity correction per meter of slot error (1/s).
+    double maxSpeed = 15.0;       // Follower ground speed limit (m/s).
+    double climbGain = 0.5;       // Climb rate per meter of altitude error (1/s).
+    double maxClimbRate = 3.0;    // m/s.
+    double separation = 2.0;      // Grid neighbors closer than this push apart (meters).
+    double separationGain = 1.0;  // Push (m/s) per meter inside the separation distance.
+};
+
+class FormationStrategy : public MovementStrategy
+{
+public:
+    explicit FormationStrategy(const FormationConfig &config = FormationConfig());
+
+    // Single drone without a fleet: flies as its own leader.
+    TelemetrySnapshot step(const TelemetrySnapshot &current, double dt) override;
+
+    // Solves every member's slot from the fleet's leader and neighbor columns.
+    void stepBatch(FleetState &fleet, const std::vector<int> &members, double dt) override;
+
+    // Makes drone the leader of group (instead of the group's lowest-indexed drone). -1 restores the default.
+    // Ignored while the drone is not a member of that group.
+    void setLeader(int group, int drone);
+
+    // Leader of group in the last stepBatch(), or -1.
+    int leaderOf(int group) const { return group >= 0 && group < int(m_groupLeader.size()) ? m_groupLeader[group] : -1; }
+
+    // Grid offset of a slot in the leader's body frame: meters ahead (negative = behind) and to the right.
+    void slotOffset(int rank, double &forward, double &right) const;
+
+private:
+    void resolveLeaders(const FleetState &fleet); // Fills m_groupLeader.
+
+    FormationConfig m_config;
+
+    std::vector<int> m_explicitLeader; // By group, -1 = default.
+    std::vector<int> m_groupLeader;    // By group, resolved every step.
+
+    // --- per group, scratch reused every tick ---
+    std::vector<int> m_slotMember; // Followers by group, each group ranked: member positions k.
+    std::vector<int> m_slotStart;  // Group g occupies m_slotMember[m_slotStart[g], m_slotStart[g + 1]).
+    std::vector<double> m_leaderEast, m_leaderNorth, m_leaderAlt; // Read buffer, in the common frame.
+    std::vector<double> m_leaderVe, m_leaderVn, m_leaderSin, m_leaderCos;
+    std::vector<double> m_regionEast, m_regionNorth; // Region origins in the common frame.
+
+    // --- per member (position k in members), read and write buffers ---
+    std::vector<int> m_group, m_rank;  // -1 rank = leader of its group.
+    std::vector<double> m_readEast, m_readNorth, m_readAlt; // Common frame.
+    std::vector<double> m_writeEast, m_writeNorth, m_writeAlt, m_writeSpeed, m_writeHeading;
+
+    // --- step() without a fleet, reused so a single step does not allocate ---
+    FleetState m_single;
+    std::vector<int> m_singleMembers;
+};
@@ -0,0 +1,100 @@
+#include "GpsNoiseModel.h"
+
+#include <algorithm>
+
+#include <cmath>
+
+GpsNoiseModel::GpsNoiseModel(std::uint64_t seed) : m_rng(seed) {}
+
+void GpsNoiseModel::resize(int droneCount)
+{
+
+    m_north.resize(droneCount, 0.0);
+
+    m_east.resize(droneCount, 0.0);
+
+    m_up.resize(droneCount, 0.0);
+
+    m_gauss.resize(std::size_t(droneCount) * 3);
+
+    m_uniforms.resize(droneCount);
+}
+
+void GpsNoiseModel::step(const FleetState &fleet, double dt)
+{
+
+    const int n = std::min(fleet.size(), int(m_north.size()));
+
+    if (n == 0 || dt <= 0.0)
+        return;
+
+    // Gauss-Markov: e' = a*e + sigma*sqrt(1 - a^2)*w keeps the stationary
+    // variance at sigma^2 whatever dt is
+
+    const double a = m_config.correlationSec > 0.0 ? std::exp(-dt / m_config.correlationSec) : 0.0;
+
+    const double q = std::sqrt(1.0 - a * a);
+
+    // per-fix coefficients, indexed by GpsFix: without a fix the error is held
+
+    const double decay[3] = {1.0, a, a};
+
+    const double drive[3] = {0.0, q * m_config.uereMeters * m_config.hdop2D, q * m_config.uereMeters * m_config.hdop3D};
+
+    const double vertical = m_config.verticalFactor;
+
+    const double jumpProbability = m_config.multipathRate > 0.0 ? 1.0 - std::exp(-m_config.multipathRate * dt) : 0.0;
+
+    double *g = m_gauss.data();
+
+    m_rng.fillGaussian(g, std::size_t(n) * 3);
+
+    for (int i = 0; i < n; ++i)
+    {
+
+        const int fix = int(fleet.gpsFix[i]);
+
+        const double d = decay[fix];
+
+        const double s = drive[fix];
+
+        m_north[i] = d * m_north[i] + s * g[3 * i];
+
+        m_east[i] = d * m_east[i] + s * g[3 * i + 1];
+
+        m_up[i] = d * m_up[i] + s * vertical * g[3 * i + 2];
+    }
+
+    if (jumpProbability <= 0.0)
+        return;
+
+    // multipath: rare step in the horizontal error, decays with the process above
+
+    m_rng.fillUniform(m_uniforms.data(), n);
+
+    for (int i = 0; i < n; ++i)
+    {
+
+        if (m_uniforms[i] < jumpProbability && fleet.gpsFix[i] != TelemetrySnapshot::GpsFix::NoFix)
+        {
+
+            m_north[i] += m_config.multipathSigmaMeters * m_rng.gaussian();
+
+            m_east[i] += m_config.multipathSigmaMeters * m_rng.gaussian();
+        }
+    }
+}
+
+void GpsNoiseModel::apply(const FleetState &fleet, int i, TelemetrySnapshot &snap) const
+{
+
+    // meters -> degrees with the region's precomputed scales, no per-drone cos()
+
+    const EnuFrame &frame = fleet.regions[fleet.region[i]];
+
+    snap.latitude += m_north[i] / frame.metersPerDegreeLatitude();
+
+    snap.longitude += m_east[i] / frame.metersPerDegreeLongitude();
+
+    snap.altitude += m_up[i];
+}
@@ -0,0 +1,71 @@
+/******************************************************************************
+ * GpsNoiseModel.h
+ * Author: Jatin Kumawat
+ * Date: 19-10-2026
+ *
+ * Description:
+ *   Receiver-like GPS position error for the published telemetry.
+ *
+ *   - First-order Gauss-Markov error per axis (north, east, up), so the
+ *  error wanders slowly instead of jumping every tick
+ *   - Error magnitude scales with HDOP, which depends on the fix quality
+ *   - Occasional multipath jumps that decay through the same process
+ *   - Evaluated in batch: one block of Gaussians per tick for the fleet
+ ******************************************************************************/
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include "FleetState.h"
+#include "FastRandom.h"
+
+// Fleet-wide receiver error parameters.
+struct GpsNoiseConfig
+{
+    double uereMeters = 2.0;            // User equivalent range error (1 sigma).
+    double correlationSec = 60.0;       // Gauss-Markov time constant.
+    double verticalFactor = 1.6;        // VDOP / HDOP ratio.
+    double hdop3D = 0.9;                // HDOP with a 3D fix.
+    double hdop2D = 2.5;                // HDOP with a 2D fix.
+    double multipathRate = 0.005;       // Multipath jumps per second.
+    double multipathSigmaMeters = 6.0;  // Size of a multipath jump (1 sigma).
+};
+
+class GpsNoiseModel
+{
+public:
+    explicit GpsNoiseModel(std::uint64_t seed = 0x6E0153ull);
+
+    void setConfig(const GpsNoiseConfig &config) { m_config = config; } // Call before start().
+
+    const GpsNoiseConfig &config() const { return m_config; } // Current parameters.
+
+    // Grows the per-drone columns to match the fleet. Call whenever drones are added.
+    void resize(int droneCount);
+
+    // Advances every drone's error by dt seconds. Tick thread only.
+    void step(const FleetState &fleet, double dt);
+
+    // Adds drone i's current error to its published position (scaled in drone i's region frame).
+    void apply(const FleetState &fleet, int i, TelemetrySnapshot &snap) const;
+
+    double errorNorth(int i) const { return m_north[i]; } // Current error, meters.
+
+    double errorEast(int i) const { return m_east[i]; } // Current error, meters.
+
+    double errorUp(int i) const { return m_up[i]; } // Current error, meters.
+
+private:
+    GpsNoiseConfig m_config; // Receiver parameters.
+
+    FastRandom m_rng; // Source of Gaussians and multipath draws.
+
+    std::vector<double> m_gauss; // Scratch: 3 Gaussians per drone per tick.
+
+    std::vector<double> m_uniforms; // Scratch: 1 uniform per drone per tick.
+
+    std::vector<double> m_north; // Error columns, meters.
+    std::vector<double> m_east;
+    std::vector<double> m_up;
+};
@@ -9,11 +9,13 @@ TelemetrySnapshot HoverStrategy::step(const TelemetrySnapshot &current, double d
 
     TelemetrySnapshot next = current;
 
-    double jitter = 0.00001;
+    // physical hover drift only; receiver noise is added by GpsNoiseModel
 
-    next.latitude += randRange(-1.0, 1.0) * jitter;
+    double jitter = 0.000005;
 
-    next.longitude += randRange(-1.0, 1.0) * jitter;
+    next.latitude += randGaussian(jitter);
+
+    next.longitude += randGaussian(jitter);
 
     next.heading = fmod(next.heading + randRange(-1.0, 1.0), 360.0);
 
@@ -22,4 +24,26 @@ TelemetrySnapshot HoverStrategy::step(const TelemetrySnapshot &current, double d
     next.speed = std::max(0.0, next.speed * 0.98);
 
     return next;
-}
\ No newline at end of file
+}
+
+void HoverStrategy::stepBatch(FleetState &fleet, const std::vector<int> &members, double dt)
+{
+
+    // 0.000005 deg of latitude is about 0.56 m
+
+    const double jitterMeters = 0.56;
+
+    for (int i : members)
+    {
+
+        fleet.north[i] += randGaussian(jitterMeters);
+
+        fleet.east[i] += randGaussian(jitterMeters);
+
+        fleet.heading[i] = fmod(fleet.heading[i] + randRange(-1.0, 1.0), 360.0);
+
+        fleet.battery[i] = std::max(0, fleet.battery[i] - (int)(dt * 0.02));
+
+        fleet.speed[i] = std::max(0.0, fleet.speed[i] * 0.98);
+    }
+}
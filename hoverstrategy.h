@@ -22,4 +22,7 @@ class HoverStrategy : public MovementStrategy
 public:
     // Calculates and returns the next telemetry snapshot based on minimal drift movement.
     TelemetrySnapshot step(const TelemetrySnapshot &current, double dt) override;
+
+    // Same drift applied directly to the fleet's ENU columns (jitter in meters).
+    void stepBatch(FleetState &fleet, const std::vector<int> &members, double dt) override;
 };
\ No newline at end of file
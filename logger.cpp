@@ -2,6 +2,10 @@
 
 #include <QDateTime>
 
+#include "MemoryAccounting.h"
+
+#include "Tracing.h"
+
 Logger &Logger::instance()
 {
 
@@ -15,8 +19,12 @@ Logger::Logger(QObject *parent) : QObject(parent) {}
 void Logger::log(const QString &msg)
 {
 
+    TraceScope trace("log", "logger");
+
     QMutexLocker locker(&m_mutex);
 
+    MemoryScope scope(MemorySubsystem::Logger);
+
     QString entry = QDateTime::currentDateTime().toString(Qt::ISODate) + " - " + msg;
 
     // emit as queued to be thread-safe when invoked from other threads
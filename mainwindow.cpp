@@ -6,14 +6,22 @@
 
 #include "Logger.h"
 
-#include <QMetaType>
+#include "MemoryAccounting.h"
 
-#include "RandomWalkStrategy.h"
+#include "Tracing.h"
 
-#include "HoverStrategy.h"
+#include <QMetaType>
 
 #include <QDateTime>
 
+#include <QStatusBar>
+
+#include <QShortcut>
+
+#include <QDir>
+
+#include <cmath>
+
 MainWindow::MainWindow(QWidget *parent)
 
     : QMainWindow(parent),
@@ -24,7 +32,9 @@ MainWindow::MainWindow(QWidget *parent)
 
       m_simulator(nullptr),
 
-      m_worker(new DroneWorker(this))
+      m_worker(new DroneWorker(this)),
+
+      m_displayTimer(new QTimer(this))
 
 {
 
@@ -36,6 +46,10 @@ MainWindow::MainWindow(QWidget *parent)
 
     ui->comboStrategy->addItem("Random Walk", QVariant::fromValue(StrategyType::RandomWalk));
 
+    ui->comboStrategy->addItem("Point Mass (wind)", QVariant::fromValue(StrategyType::PointMass));
+
+    ui->comboStrategy->addItem("Formation", QVariant::fromValue(StrategyType::Formation));
+
     ui->btnStart->setEnabled(true);
 
     ui->btnStop->setEnabled(false);
@@ -52,11 +66,40 @@ MainWindow::MainWindow(QWidget *parent)
 
     connect(m_model, &TelemetryModel::telemetryUpdated, this, &MainWindow::onTelemetryUpdated);
 
+    // derived values shown in the status bar; the model computes only these
+
+    for (int metric : {DerivedMetric::DistanceToHome, DerivedMetric::TimeToHome, DerivedMetric::RemainingFlightTime, DerivedMetric::RemainingRange})
+        m_model->subscribeMetric(metric);
+
+    // smoothed position at the display rate, independent of the simulator tick
+
+    m_displayTimer->setTimerType(Qt::PreciseTimer);
+
+    m_displayTimer->setInterval(16);
+
+    connect(m_displayTimer, &QTimer::timeout, this, &MainWindow::onDisplayFrame);
+
     // logger
 
     connect(&Logger::instance(), &Logger::newLog, this, &MainWindow::appendLog);
 
+    // timeline tracing of every thread, e.g. DRONE_TRACE=/tmp/drone-trace.json traces from startup
+
+    Tracing::setThreadName("ui");
+
+    m_tracePath = qEnvironmentVariable("DRONE_TRACE");
+
+    const bool traceFromStart = !m_tracePath.isEmpty();
+
+    if (!traceFromStart)
+        m_tracePath = QDir::temp().filePath("drone-trace.json");
+
+    connect(new QShortcut(QKeySequence("Ctrl+Shift+T"), this), &QShortcut::activated, this, &MainWindow::onToggleTracing);
+
     appendLog("MainWindow initialized.");
+
+    if (traceFromStart)
+        onToggleTracing();
 }
 
 MainWindow::~MainWindow()
@@ -68,6 +111,16 @@ MainWindow::~MainWindow()
         m_worker->stopSimulator();
     }
 
+    // a trace still running at exit is written out
+
+    if (Tracing::enabled())
+    {
+
+        Tracing::setEnabled(false);
+
+        Tracing::exportChromeTrace(m_tracePath);
+    }
+
     delete ui;
 }
 
@@ -88,8 +141,53 @@ void MainWindow::onStartClicked()
     connect(m_simulator, &DroneSimulator::eventOccurred, [](const QString &s)
             { Logger::instance().log(s); });
 
+    // external processes (ground station, recorders) read the stream from shared memory
+
+    QString busError;
+
+    if (!m_simulator->openTelemetryBus("/drone-telemetry", &busError))
+        appendLog("Telemetry bus unavailable: " + busError);
+
+    // optional UDP stream for ingest services, e.g. DRONE_UDP_TARGET=127.0.0.1:14550
+
+    const QString udpTarget = qEnvironmentVariable("DRONE_UDP_TARGET");
+
+    const int colon = udpTarget.lastIndexOf(':');
+
+    if (colon > 0)
+    {
+
+        QString udpError;
+
+        if (!m_simulator->openUdpPublisher(udpTarget.left(colon), quint16(udpTarget.mid(colon + 1).toUInt()), &udpError))
+            appendLog("UDP publisher unavailable: " + udpError);
+        else
+            appendLog("Streaming telemetry over UDP to " + udpTarget);
+    }
+
+    // optional columnar recording for offline analysis, e.g. DRONE_RECORDING=/tmp/run.dtcol
+
+    const QString recording = qEnvironmentVariable("DRONE_RECORDING");
+
+    if (!recording.isEmpty())
+    {
+
+        QString recordingError;
+
+        if (!m_simulator->openRecording(recording, &recordingError))
+            appendLog("Recording unavailable: " + recordingError);
+        else
+            appendLog("Recording telemetry to " + recording);
+    }
+
     m_worker->startSimulator(m_simulator);
 
+    m_reckoner.clear();
+
+    m_shownTrack = -1;
+
+    m_displayTimer->start();
+
     ui->btnStart->setEnabled(false);
 
     ui->btnStop->setEnabled(true);
@@ -105,6 +203,8 @@ void MainWindow::onStopClicked()
 
     m_worker->stopSimulator();
 
+    m_displayTimer->stop();
+
     // delete simulator object (it is parented to no one)
 
     m_simulator->deleteLater();
@@ -116,6 +216,25 @@ void MainWindow::onStopClicked()
     ui->btnStop->setEnabled(false);
 
     appendLog("Simulator stopped.");
+
+    // heap use per subsystem (only counted in DRONE_MEMORY_ACCOUNTING builds)
+
+    if (MemoryAccounting::hooksInstalled())
+    {
+
+        for (int sub = 0; sub < MemorySubsystem::Count; ++sub)
+        {
+
+            const MemoryStats stats = MemoryAccounting::stats(sub);
+
+            appendLog(QString("Memory %1: %2 KB live, %3 KB peak, %4 allocations, %5 in the last tick")
+                          .arg(MemoryAccounting::name(sub))
+                          .arg(stats.liveBytes / 1024)
+                          .arg(stats.peakBytes / 1024)
+                          .arg(stats.allocations)
+                          .arg(stats.lastTickAllocations));
+        }
+    }
 }
 
 void MainWindow::onSimulateFailureToggled(bool checked)
@@ -124,9 +243,18 @@ void MainWindow::onSimulateFailureToggled(bool checked)
     if (m_simulator)
     {
 
-        QMetaObject::invokeMethod(m_simulator, "setFailureMode", Qt::QueuedConnection, Q_ARG(bool, checked));
+        // lock-free hand-off, applied by the simulator at its next tick
+
+        if (m_simulator->submitCommand(FleetCommand::setFailureMode(checked)))
+        {
+
+            appendLog(QString("Failure mode toggled: %1").arg(checked ? "ON" : "OFF"));
+        }
+        else
+        {
 
-        appendLog(QString("Failure mode toggled: %1").arg(checked ? "ON" : "OFF"));
+            appendLog("Failure toggle dropped: simulator command queue is full.");
+        }
     }
     else
     {
@@ -145,46 +273,32 @@ void MainWindow::onStrategyChanged(int idx)
 
     int strat = ui->comboStrategy->itemData(idx).toInt();
 
-    // create new strategy on the heap and set by queued call
+    // the simulator already owns every strategy, the command only selects one
 
-    MovementStrategy *newStr = nullptr;
-
-    if (strat == StrategyType::RandomWalk)
+    if (m_simulator->submitCommand(FleetCommand::setStrategy(strat)))
     {
 
-        newStr = new RandomWalkStrategy();
+        appendLog("Strategy switch queued.");
     }
     else
     {
 
-        newStr = new HoverStrategy();
+        appendLog("Strategy switch dropped: simulator command queue is full.");
     }
-
-    // wrap in unique_ptr via lambda in simulator thread
-
-    QMetaObject::invokeMethod(m_simulator, [this, newStr]()
-                              {
-                                  std::unique_ptr<MovementStrategy> ptr(newStr);
-
-                                  m_simulator->setStrategy(std::move(ptr));
-
-                                  Logger::instance().log("Strategy switched in simulator."); }, Qt::QueuedConnection);
 }
 
 void MainWindow::onTelemetryUpdated()
 {
 
-    TelemetrySnapshot snap = m_model->snapshot();
+    TraceScope trace("onTelemetryUpdated", "ui");
 
-    ui->lblDroneId->setText(snap.id);
-
-    ui->lblLat->setText(QString::number(snap.latitude, 'f', 6));
+    TelemetrySnapshot snap = m_model->snapshot();
 
-    ui->lblLon->setText(QString::number(snap.longitude, 'f', 6));
+    // position, altitude and heading are drawn by onDisplayFrame() from the dead-reckoned track
 
-    ui->lblAlt->setText(QString::number(snap.altitude, 'f', 2));
+    m_shownTrack = m_reckoner.update(snap, QDateTime::currentMSecsSinceEpoch());
 
-    ui->lblHeading->setText(QString::number(snap.heading, 'f', 1));
+    ui->lblDroneId->setText(snap.id);
 
     ui->lblSpeed->setText(QString::number(snap.speed, 'f', 2));
 
@@ -196,12 +310,87 @@ void MainWindow::onTelemetryUpdated()
                                                                     : "No Fix";
 
     ui->lblGps->setText(fix);
+
+    const double home = m_model->metric(snap.id, DerivedMetric::DistanceToHome);
+
+    const double toHome = m_model->metric(snap.id, DerivedMetric::TimeToHome);
+
+    const double flight = m_model->metric(snap.id, DerivedMetric::RemainingFlightTime);
+
+    const double range = m_model->metric(snap.id, DerivedMetric::RemainingRange);
+
+    auto minutes = [](double seconds)
+    { return std::isfinite(seconds) ? QString::number(seconds / 60.0, 'f', 1) + " min" : QString("--"); };
+
+    statusBar()->showMessage(QString("Home %1 m (%2)  |  Battery left %3, range %4")
+                                 .arg(QString::number(home, 'f', 0), minutes(toHome), minutes(flight),
+                                      std::isfinite(range) ? QString::number(range / 1000.0, 'f', 2) + " km" : QString("--")));
+}
+
+void MainWindow::onDisplayFrame()
+{
+
+    if (m_shownTrack < 0)
+        return;
+
+    TraceScope trace("onDisplayFrame", "ui");
+
+    // one pass over every track; a map view would draw all of them from here
+
+    m_reckoner.advance(QDateTime::currentMSecsSinceEpoch());
+
+    const TelemetrySnapshot shown = m_reckoner.displayed(m_shownTrack);
+
+    ui->lblLat->setText(QString::number(shown.latitude, 'f', 6));
+
+    ui->lblLon->setText(QString::number(shown.longitude, 'f', 6));
+
+    ui->lblAlt->setText(QString::number(shown.altitude, 'f', 2));
+
+    ui->lblHeading->setText(QString::number(shown.heading, 'f', 1));
 }
 
 void MainWindow::appendLog(const QString &entry)
 {
 
+    TraceScope trace("appendLog", "ui");
+
     QString msg = QDateTime::currentDateTime().toString(Qt::ISODate) + " - " + entry;
 
     ui->logView->appendPlainText(msg);
 }
+
+
+void MainWindow::onToggleTracing()
+{
+
+    if (!Tracing::enabled())
+    {
+
+        Tracing::clear();
+
+        Tracing::setEnabled(true);
+
+        appendLog("Tracing started (Ctrl+Shift+T writes " + m_tracePath + ").");
+
+        return;
+    }
+
+    Tracing::setEnabled(false);
+
+    QString error;
+
+    if (Tracing::exportChromeTrace(m_tracePath, &error))
+    {
+
+        appendLog(QString("Trace written to %1 (%2 events, %3 dropped); open it in ui.perfetto.dev or chrome://tracing.")
+                      .arg(m_tracePath)
+                      .arg(Tracing::eventsRecorded())
+                      .arg(Tracing::eventsDropped()));
+    }
+    else
+    {
+
+        appendLog("Trace not written: " + error);
+    }
+}
\ No newline at end of file
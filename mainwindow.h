@@ -1,10 +1,12 @@
 #pragma once
 
 #include <QMainWindow>
+#include <QTimer>
 #include <memory>
 #include "TelemetryModel.h"
 #include "DroneSimulator.h"
 #include "DroneWorker.h"
+#include "DeadReckoner.h"
 
 QT_BEGIN_NAMESPACE
 namespace Ui
@@ -24,15 +26,21 @@ public:
 
 private slots:
     void onTelemetryUpdated();                   // Slot: Updates the UI display with new telemetry data from the model.
+    void onDisplayFrame();                       // Slot: Redraws the smoothed position at the display refresh rate.
     void onStartClicked();                       // Slot: Handles the button press to start the drone simulation.
     void onStopClicked();                        // Slot: Handles the button press to stop the drone simulation.
     void onSimulateFailureToggled(bool checked); // Slot: Handles the checkbox state change for simulating a drone failure.
     void onStrategyChanged(int idx);             // Slot: Handles selection change for movement strategy (e.g., hover).
     void appendLog(const QString &entry);        // Slot: Appends a new message to the log display area.
+    void onToggleTracing();                      // Slot: Starts a trace, or stops it and writes the trace file (Ctrl+Shift+T).
 
 private:
     Ui::MainWindow *ui;          // Pointer to the compiled UI object (all the widgets).
     TelemetryModel *m_model;     // Model holding the current drone telemetry data.
     DroneSimulator *m_simulator; // The core simulation object generating data.
     DroneWorker *m_worker;       // The thread managing the execution of the simulator.
+    DeadReckoner m_reckoner;     // Smooths positions between simulator ticks for display.
+    QTimer *m_displayTimer;      // Drives onDisplayFrame() at about 60 fps while the simulator runs.
+    int m_shownTrack = -1;       // Reckoner track of the drone shown in the labels.
+    QString m_tracePath;         // Chrome trace file written when tracing stops (DRONE_TRACE or the temp dir).
 };
\ No newline at end of file
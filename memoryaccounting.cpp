@@ -0,0 +1,300 @@
+#include "MemoryAccounting.h"
+
+#include <algorithm>
+
+#include <atomic>
+
+#include <cstdint>
+
+// constant-initialized: operator new may run before any dynamic initializer
+
+namespace
+{
+
+    struct Counters
+    {
+        std::atomic<long long> live{0};
+        std::atomic<long long> peak{0};
+        std::atomic<long long> allocations{0};
+        std::atomic<long long> frees{0};
+        std::atomic<long long> tickAllocations{0};
+        std::atomic<long long> lastTickAllocations{0};
+    };
+
+    Counters g_counters[MemorySubsystem::Count];
+
+    std::atomic<bool> g_hooks{false};
+
+    std::atomic<bool> g_zeroAllocationTicks{false};
+
+    std::atomic<long long> g_violations{0};
+
+    std::atomic<long long> g_ticks{0};
+
+    thread_local int t_subsystem = MemorySubsystem::Other;
+
+    thread_local bool t_inTick = false;
+
+    int valid(int subsystem)
+    {
+
+        return subsystem >= 0 && subsystem < MemorySubsystem::Count ? subsystem : int(MemorySubsystem::Other);
+    }
+}
+
+void MemoryAccounting::charge(int subsystem, std::size_t bytes)
+{
+
+    Counters &c = g_counters[valid(subsystem)];
+
+    const long long live = c.live.fetch_add((long long)bytes, std::memory_order_relaxed) + (long long)bytes;
+
+    long long peak = c.peak.load(std::memory_order_relaxed);
+
+    while (live > peak && !c.peak.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+    {
+    }
+
+    c.allocations.fetch_add(1, std::memory_order_relaxed);
+
+    if (t_inTick)
+        c.tickAllocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+void MemoryAccounting::release(int subsystem, std::size_t bytes)
+{
+
+    Counters &c = g_counters[valid(subsystem)];
+
+    c.live.fetch_sub((long long)bytes, std::memory_order_relaxed);
+
+    c.frees.fetch_add(1, std::memory_order_relaxed);
+}
+
+int MemoryAccounting::currentSubsystem()
+{
+
+    return t_subsystem;
+}
+
+MemoryStats MemoryAccounting::stats(int subsystem)
+{
+
+    const Counters &c = g_counters[valid(subsystem)];
+
+    MemoryStats s;
+
+    s.liveBytes = c.live.load(std::memory_order_relaxed);
+
+    s.peakBytes = c.peak.load(std::memory_order_relaxed);
+
+    s.allocations = c.allocations.load(std::memory_order_relaxed);
+
+    s.frees = c.frees.load(std::memory_order_relaxed);
+
+    s.lastTickAllocations = c.lastTickAllocations.load(std::memory_order_relaxed);
+
+    return s;
+}
+
+const char *MemoryAccounting::name(int subsystem)
+{
+
+    static const char *const names[MemorySubsystem::Count] = {"other", "simulator", "strategies", "events", "logger", "model"};
+
+    return names[valid(subsystem)];
+}
+
+bool MemoryAccounting::hooksInstalled()
+{
+
+    return g_hooks.load(std::memory_order_relaxed);
+}
+
+void MemoryAccounting::markHooksInstalled()
+{
+
+    g_hooks.store(true, std::memory_order_relaxed);
+}
+
+void MemoryAccounting::setZeroAllocationTicks(bool enabled)
+{
+
+    g_zeroAllocationTicks.store(enabled, std::memory_order_relaxed);
+}
+
+bool MemoryAccounting::zeroAllocationTicks()
+{
+
+    return g_zeroAllocationTicks.load(std::memory_order_relaxed);
+}
+
+long long MemoryAccounting::zeroAllocationViolations()
+{
+
+    return g_violations.load(std::memory_order_relaxed);
+}
+
+long long MemoryAccounting::ticks()
+{
+
+    return g_ticks.load(std::memory_order_relaxed);
+}
+
+void MemoryAccounting::resetStatistics()
+{
+
+    for (Counters &c : g_counters)
+    {
+
+        c.peak.store(c.live.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+        c.allocations.store(0, std::memory_order_relaxed);
+
+        c.frees.store(0, std::memory_order_relaxed);
+
+        c.tickAllocations.store(0, std::memory_order_relaxed);
+
+        c.lastTickAllocations.store(0, std::memory_order_relaxed);
+    }
+
+    g_violations.store(0, std::memory_order_relaxed);
+
+    g_ticks.store(0, std::memory_order_relaxed);
+}
+
+MemoryScope::MemoryScope(int subsystem) : m_previous(t_subsystem)
+{
+
+    t_subsystem = valid(subsystem);
+}
+
+MemoryScope::~MemoryScope()
+{
+
+    t_subsystem = m_previous;
+}
+
+TickScope::TickScope() : m_scope(MemorySubsystem::Simulator)
+{
+
+    t_inTick = true;
+}
+
+TickScope::~TickScope()
+{
+
+    t_inTick = false;
+
+    long long total = 0;
+
+    for (Counters &c : g_counters)
+    {
+
+        const long long n = c.tickAllocations.exchange(0, std::memory_order_relaxed);
+
+        c.lastTickAllocations.store(n, std::memory_order_relaxed);
+
+        total += n;
+    }
+
+    g_ticks.fetch_add(1, std::memory_order_relaxed);
+
+    if (total > 0 && g_zeroAllocationTicks.load(std::memory_order_relaxed))
+        g_violations.fetch_add(1, std::memory_order_relaxed);
+}
+
+void *AccountedResource::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+
+    void *p = m_upstream->allocate(bytes, alignment);
+
+    MemoryAccounting::charge(m_subsystem, bytes);
+
+    return p;
+}
+
+void AccountedResource::do_deallocate(void *p, std::size_t bytes, std::size_t alignment)
+{
+
+    m_upstream->deallocate(p, bytes, alignment);
+
+    MemoryAccounting::release(m_subsystem, bytes);
+}
+
+static std::size_t alignUp(std::size_t offset, std::size_t alignment)
+{
+
+    return (offset + alignment - 1) & ~(alignment - 1);
+}
+
+TickArena::TickArena(std::size_t initialBytes, std::pmr::memory_resource *upstream) : m_upstream(upstream)
+{
+
+    m_capacity = std::max<std::size_t>(initialBytes, 256);
+
+    m_block = static_cast<char *>(m_upstream->allocate(m_capacity, alignof(std::max_align_t)));
+}
+
+TickArena::~TickArena()
+{
+
+    rewind();
+
+    m_upstream->deallocate(m_block, m_capacity, alignof(std::max_align_t));
+}
+
+void *TickArena::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+
+    m_tickBytes += bytes + alignment;
+
+    // the block is only max_align_t-aligned: align the address, not the offset
+
+    const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(m_block);
+
+    const std::size_t offset = std::size_t(alignUp(base + m_used, alignment) - base);
+
+    if (offset + bytes <= m_capacity)
+    {
+
+        m_used = offset + bytes;
+
+        return m_block + offset;
+    }
+
+    // block full: borrow from upstream until the next rewind()
+
+    void *p = m_upstream->allocate(bytes, alignment);
+
+    m_overflow.push_back({p, bytes, alignment});
+
+    return p;
+}
+
+void TickArena::rewind()
+{
+
+    for (const Overflow &o : m_overflow)
+        m_upstream->deallocate(o.block, o.bytes, o.alignment);
+
+    // the tick did not fit: grow once to what it needed (padding included), so the same tick fits next time
+
+    if (!m_overflow.empty() && m_tickBytes > m_capacity)
+    {
+
+        m_upstream->deallocate(m_block, m_capacity, alignof(std::max_align_t));
+
+        m_capacity = m_tickBytes;
+
+        m_block = static_cast<char *>(m_upstream->allocate(m_capacity, alignof(std::max_align_t)));
+    }
+
+    m_overflow.clear();
+
+    m_highWater = std::max(m_highWater, m_tickBytes);
+
+    m_used = 0;
+
+    m_tickBytes = 0;
+}
@@ -0,0 +1,167 @@
+/******************************************************************************
+ * MemoryAccounting.h
+ * Author: Jatin Kumawat
+ * Date: 19-10-2026
+ *
+ * Description:
+ *   Heap accounting per subsystem, and allocation budgets for the tick.
+ *
+ *   - Every allocation is charged to the subsystem of the innermost
+ *  MemoryScope on the allocating thread; frees are credited back to the
+ *  subsystem that allocated, whatever thread frees (queued events)
+ *   - Per subsystem: bytes live, peak, allocation/free counts, and the
+ *  allocations made during the last simulation tick (TickScope)
+ *   - Zero-allocation mode: every tick that allocates counts as a
+ *  violation, so tests can assert that the steady-state tick is heap-free
+ *   - Allocations reach the counters through the allocator replacement in
+ *  MemoryHooks.cpp (malloc family on glibc, so Qt container buffers count
+ *  too; operator new elsewhere), linked when DRONE_MEMORY_ACCOUNTING is
+ *  ON, and through AccountedResource for std::pmr containers
+ *   - TickArena: pmr bump allocator rewound every tick, for scratch that
+ *  lives one tick; it settles on one block and then never touches the heap
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+// Subsystems memory is charged to.
+namespace MemorySubsystem
+{
+    enum Type
+    {
+        Other = 0,      // Anything outside a MemoryScope.
+        Simulator = 1,  // Tick bookkeeping, fleet columns, faults, noise, publication.
+        Strategies = 2, // Movement strategies (stepBatch).
+        Events = 3,     // Queued signal events carrying telemetry to other threads.
+        Logger = 4,     // Log message strings.
+        Model = 5,      // TelemetryModel copies and derived metrics.
+        Count           // Number of subsystems (not a subsystem).
+    };
+}
+
+// Counters of one subsystem.
+struct MemoryStats
+{
+    long long liveBytes = 0;           // Allocated and not yet freed.
+    long long peakBytes = 0;           // Highest liveBytes seen.
+    long long allocations = 0;         // Total allocations.
+    long long frees = 0;               // Total frees.
+    long long lastTickAllocations = 0; // Allocations during the last finished tick.
+};
+
+class MemoryAccounting
+{
+public:
+    // Charges / credits bytes to a subsystem. Lock-free and allocation-free (called from malloc / operator new).
+    static void charge(int subsystem, std::size_t bytes);
+
+    static void release(int subsystem, std::size_t bytes);
+
+    static int currentSubsystem(); // Subsystem of the calling thread's innermost MemoryScope.
+
+    static MemoryStats stats(int subsystem);
+
+    static const char *name(int subsystem);
+
+    // True when the global allocator feeds the counters (MemoryHooks.cpp is linked).
+    static bool hooksInstalled();
+
+    // Zero-allocation mode: a tick that allocates anything counts as a violation.
+    static void setZeroAllocationTicks(bool enabled);
+
+    static bool zeroAllocationTicks();
+
+    static long long zeroAllocationViolations(); // Ticks that allocated while the mode was on.
+
+    static long long ticks(); // Finished TickScopes.
+
+    static void resetStatistics(); // Clears peaks (to the live size), counts and violations; live bytes are kept.
+
+    static void markHooksInstalled(); // Called by MemoryHooks.cpp during static initialization.
+};
+
+// Charges the calling thread's allocations to a subsystem for the scope's lifetime.
+class MemoryScope
+{
+public:
+    explicit MemoryScope(int subsystem);
+    ~MemoryScope();
+
+    MemoryScope(const MemoryScope &) = delete;
+    MemoryScope &operator=(const MemoryScope &) = delete;
+
+private:
+    int m_previous;
+};
+
+// Marks one simulation tick on the calling thread (charged to Simulator unless nested scopes say otherwise).
+// Tick counters assume one ticking thread.
+class TickScope
+{
+public:
+    TickScope();
+    ~TickScope();
+
+    TickScope(const TickScope &) = delete;
+    TickScope &operator=(const TickScope &) = delete;
+
+private:
+    MemoryScope m_scope;
+};
+
+// pmr resource charging a subsystem for what it takes from its upstream resource.
+class AccountedResource : public std::pmr::memory_resource
+{
+public:
+    explicit AccountedResource(int subsystem, std::pmr::memory_resource *upstream = std::pmr::new_delete_resource())
+        : m_subsystem(subsystem), m_upstream(upstream) {}
+
+private:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+
+    int m_subsystem;
+    std::pmr::memory_resource *m_upstream;
+};
+
+// Per-tick scratch arena: bump allocation, freed all at once by rewind(). When a tick outgrew the
+// block, rewind() replaces it with one block as large as that tick needed, so a steady-state tick
+// makes no heap allocation. Not thread-safe (one tick thread).
+class TickArena : public std::pmr::memory_resource
+{
+public:
+    explicit TickArena(std::size_t initialBytes = 64 * 1024, std::pmr::memory_resource *upstream = std::pmr::new_delete_resource());
+    ~TickArena() override;
+
+    TickArena(const TickArena &) = delete;
+    TickArena &operator=(const TickArena &) = delete;
+
+    void rewind(); // Releases everything allocated since the last rewind. Call at the end of a tick.
+
+    std::size_t capacity() const { return m_capacity; }    // Bytes of the main block.
+    std::size_t highWater() const { return m_highWater; } // Most bytes one tick asked for (with alignment slack).
+
+private:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void *, std::size_t, std::size_t) override {} // Freed by rewind().
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+
+    struct Overflow
+    {
+        void *block;
+        std::size_t bytes;
+        std::size_t alignment;
+    };
+
+    std::pmr::memory_resource *m_upstream;
+    char *m_block = nullptr;    // Main block.
+    std::size_t m_capacity = 0;
+    std::size_t m_used = 0;     // Bump offset in the main block.
+    std::size_t m_tickBytes = 0; // Everything requested this tick (main block and overflow).
+    std::size_t m_highWater = 0;
+    std::vector<Overflow> m_overflow; // Blocks from upstream when the main block was full.
+};
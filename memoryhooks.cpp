@@ -0,0 +1,399 @@
+/******************************************************************************
+ * MemoryHooks.cpp
+ * Author: Jatin Kumawat
+ * Date: 19-10-2026
+ *
+ * Description:
+ *   Global allocator replacement feeding MemoryAccounting.
+ *
+ *   - On glibc the malloc family itself is replaced (ELF interposition over
+ *  __libc_malloc and friends), so Qt containers (QString, QByteArray,
+ *  QList allocate with ::malloc in QArrayData) are charged like operator
+ *  new, which calls malloc
+ *   - Elsewhere only the global operator new/delete are replaced; Qt
+ *  container buffers are then not charged
+ *   - Each block carries a small header with its size and the subsystem
+ *  it was charged to, so a free is credited to the right subsystem from
+ *  any thread
+ *   - Linked only when DRONE_MEMORY_ACCOUNTING is ON (and never on Windows,
+ *  where Qt DLLs would free blocks allocated by this replacement)
+ ******************************************************************************/
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include <unistd.h>
+
+#include "MemoryAccounting.h"
+
+#if defined(__GLIBC__)
+
+// glibc's own allocator, still exported for interposers
+extern "C"
+{
+    void *__libc_malloc(std::size_t size);
+    void *__libc_memalign(std::size_t alignment, std::size_t size);
+    void *__libc_realloc(void *p, std::size_t size);
+    void __libc_free(void *p);
+}
+
+namespace
+{
+
+    // sits right before the user pointer; prefix is the distance back to the block glibc returned
+
+    struct alignas(16) Header
+    {
+        std::size_t size;
+        int subsystem;
+        unsigned prefix;
+    };
+
+    static_assert(sizeof(Header) == 16, "the header keeps malloc's 16-byte alignment");
+
+    [[maybe_unused]] const bool g_installed = (MemoryAccounting::markHooksInstalled(), true);
+
+    bool powerOfTwo(std::size_t n)
+    {
+
+        return n && !(n & (n - 1));
+    }
+
+    Header *headerOf(void *p)
+    {
+
+        return static_cast<Header *>(p) - 1;
+    }
+
+    void *allocate(std::size_t size, std::size_t alignment)
+    {
+
+        // an aligned block puts the header in the last bytes of an alignment-sized prefix
+
+        const std::size_t prefix = alignment > sizeof(Header) ? alignment : sizeof(Header);
+
+        if (size > SIZE_MAX - prefix)
+        {
+
+            errno = ENOMEM;
+
+            return nullptr;
+        }
+
+        void *base = alignment > sizeof(Header) ? __libc_memalign(alignment, prefix + size) : __libc_malloc(prefix + size);
+
+        if (!base)
+            return nullptr;
+
+        char *user = static_cast<char *>(base) + prefix;
+
+        Header *header = headerOf(user);
+
+        header->size = size;
+
+        header->subsystem = MemoryAccounting::currentSubsystem();
+
+        header->prefix = unsigned(prefix);
+
+        MemoryAccounting::charge(header->subsystem, size);
+
+        return user;
+    }
+
+    void *allocateAligned(std::size_t alignment, std::size_t size)
+    {
+
+        if (!powerOfTwo(alignment))
+        {
+
+            errno = EINVAL;
+
+            return nullptr;
+        }
+
+        return allocate(size, alignment);
+    }
+}
+
+extern "C"
+{
+
+    void *malloc(std::size_t size) { return allocate(size, 0); }
+
+    void free(void *p)
+    {
+
+        if (!p)
+            return;
+
+        const Header *header = headerOf(p);
+
+        MemoryAccounting::release(header->subsystem, header->size);
+
+        __libc_free(static_cast<char *>(p) - header->prefix);
+    }
+
+    void *calloc(std::size_t count, std::size_t size)
+    {
+
+        if (size && count > SIZE_MAX / size)
+        {
+
+            errno = ENOMEM;
+
+            return nullptr;
+        }
+
+        void *p = allocate(count * size, 0);
+
+        if (p)
+            std::memset(p, 0, count * size);
+
+        return p;
+    }
+
+    void *realloc(void *p, std::size_t size)
+    {
+
+        if (!p)
+            return allocate(size, 0);
+
+        if (size == 0)
+        {
+
+            free(p);
+
+            return nullptr;
+        }
+
+        Header *header = headerOf(p);
+
+        // aligned blocks move: glibc's realloc would not keep their alignment
+
+        if (header->prefix != sizeof(Header))
+        {
+
+            void *moved = allocate(size, 0);
+
+            if (moved)
+            {
+
+                std::memcpy(moved, p, header->size < size ? header->size : size);
+
+                free(p);
+            }
+
+            return moved;
+        }
+
+        if (size > SIZE_MAX - sizeof(Header))
+        {
+
+            errno = ENOMEM;
+
+            return nullptr;
+        }
+
+        const std::size_t oldSize = header->size;
+
+        const int oldSubsystem = header->subsystem;
+
+        void *base = __libc_realloc(static_cast<char *>(p) - sizeof(Header), sizeof(Header) + size);
+
+        if (!base)
+            return nullptr; // the old block is untouched and still charged
+
+        // counted as a free of the old block and an allocation of the new one
+
+        MemoryAccounting::release(oldSubsystem, oldSize);
+
+        char *user = static_cast<char *>(base) + sizeof(Header);
+
+        header = headerOf(user);
+
+        header->size = size;
+
+        header->subsystem = MemoryAccounting::currentSubsystem();
+
+        MemoryAccounting::charge(header->subsystem, size);
+
+        return user;
+    }
+
+    void *reallocarray(void *p, std::size_t count, std::size_t size)
+    {
+
+        if (size && count > SIZE_MAX / size)
+        {
+
+            errno = ENOMEM;
+
+            return nullptr;
+        }
+
+        return realloc(p, count * size);
+    }
+
+    int posix_memalign(void **out, std::size_t alignment, std::size_t size)
+    {
+
+        if (!powerOfTwo(alignment) || alignment % sizeof(void *) != 0)
+            return EINVAL;
+
+        void *p = allocate(size, alignment);
+
+        if (!p)
+            return ENOMEM;
+
+        *out = p;
+
+        return 0;
+    }
+
+    void *aligned_alloc(std::size_t alignment, std::size_t size) { return allocateAligned(alignment, size); }
+
+    void *memalign(std::size_t alignment, std::size_t size) { return allocateAligned(alignment, size); }
+
+    void *valloc(std::size_t size) { return allocate(size, std::size_t(sysconf(_SC_PAGESIZE))); }
+
+    void *pvalloc(std::size_t size)
+    {
+
+        const std::size_t page = std::size_t(sysconf(_SC_PAGESIZE));
+
+        return allocate((size + page - 1) & ~(page - 1), page);
+    }
+
+    std::size_t malloc_usable_size(void *p) { return p ? headerOf(p)->size : 0; }
+}
+
+#else
+
+namespace
+{
+
+    // sits right before the user pointer; keeps the default new alignment
+
+    struct alignas(alignof(std::max_align_t)) Header
+    {
+        std::size_t size;
+        int subsystem;
+    };
+
+    [[maybe_unused]] const bool g_installed = (MemoryAccounting::markHooksInstalled(), true);
+
+    void *allocate(std::size_t size, std::size_t alignment, bool nothrow)
+    {
+
+        // an aligned block puts the header in the last bytes of an alignment-sized prefix
+
+        const std::size_t prefix = alignment > sizeof(Header) ? alignment : sizeof(Header);
+
+        for (;;)
+        {
+
+            void *base = nullptr;
+
+            if (alignment > alignof(std::max_align_t))
+            {
+
+                if (posix_memalign(&base, alignment, prefix + size) != 0)
+                    base = nullptr;
+            }
+            else
+            {
+
+                base = std::malloc(prefix + size);
+            }
+
+            if (base)
+            {
+
+                char *user = static_cast<char *>(base) + prefix;
+
+                Header *header = reinterpret_cast<Header *>(user) - 1;
+
+                header->size = size;
+
+                header->subsystem = MemoryAccounting::currentSubsystem();
+
+                MemoryAccounting::charge(header->subsystem, size);
+
+                return user;
+            }
+
+            std::new_handler handler = std::get_new_handler();
+
+            if (!handler)
+            {
+
+                if (nothrow)
+                    return nullptr;
+
+                throw std::bad_alloc();
+            }
+
+            handler();
+        }
+    }
+
+    void deallocate(void *p, std::size_t alignment)
+    {
+
+        if (!p)
+            return;
+
+        const std::size_t prefix = alignment > sizeof(Header) ? alignment : sizeof(Header);
+
+        const Header *header = static_cast<const Header *>(p) - 1;
+
+        MemoryAccounting::release(header->subsystem, header->size);
+
+        std::free(static_cast<char *>(p) - prefix);
+    }
+}
+
+void *operator new(std::size_t size) { return allocate(size, 0, false); }
+
+void *operator new[](std::size_t size) { return allocate(size, 0, false); }
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept { return allocate(size, 0, true); }
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept { return allocate(size, 0, true); }
+
+void *operator new(std::size_t size, std::align_val_t a) { return allocate(size, std::size_t(a), false); }
+
+void *operator new[](std::size_t size, std::align_val_t a) { return allocate(size, std::size_t(a), false); }
+
+void *operator new(std::size_t size, std::align_val_t a, const std::nothrow_t &) noexcept { return allocate(size, std::size_t(a), true); }
+
+void *operator new[](std::size_t size, std::align_val_t a, const std::nothrow_t &) noexcept { return allocate(size, std::size_t(a), true); }
+
+void operator delete(void *p) noexcept { deallocate(p, 0); }
+
+void operator delete[](void *p) noexcept { deallocate(p, 0); }
+
+void operator delete(void *p, std::size_t) noexcept { deallocate(p, 0); }
+
+void operator delete[](void *p, std::size_t) noexcept { deallocate(p, 0); }
+
+void operator delete(void *p, const std::nothrow_t &) noexcept { deallocate(p, 0); }
+
+void operator delete[](void *p, const std::nothrow_t &) noexcept { deallocate(p, 0); }
+
+void operator delete(void *p, std::align_val_t a) noexcept { deallocate(p, std::size_t(a)); }
+
+void operator delete[](void *p, std::align_val_t a) noexcept { deallocate(p, std::size_t(a)); }
+
+void operator delete(void *p, std::size_t, std::align_val_t a) noexcept { deallocate(p, std::size_t(a)); }
+
+void operator delete[](void *p, std::size_t, std::align_val_t a) noexcept { deallocate(p, std::size_t(a)); }
+
+void operator delete(void *p, std::align_val_t a, const std::nothrow_t &) noexcept { deallocate(p, std::size_t(a)); }
+
+void operator delete[](void *p, std::align_val_t a, const std::nothrow_t &) noexcept { deallocate(p, std::size_t(a)); }
+
+#endif
@@ -0,0 +1,300 @@
+#include "PointMassStrategy.h"
+
+#include <algorithm>
+
+#include <cmath>
+
+#include "FastTrig.h"
+
+static constexpr double GRAVITY = 9.81;
+
+PointMassStrategy::PointMassStrategy(std::shared_ptr<const WindField> wind, const PointMassConfig &config, std::uint64_t seed)
+
+    : m_wind(std::move(wind)),
+
+      m_config(config),
+
+      m_rng(seed)
+
+{
+
+    if (m_wind)
+        m_windFrame = EnuFrame(m_wind->config().originLatitude, m_wind->config().originLongitude);
+}
+
+void PointMassStrategy::syncRegions(const FleetState &fleet)
+{
+
+    // regions are only ever appended, so existing offsets stay valid
+
+    for (int r = int(m_regionEast.size()); r < int(fleet.regions.size()); ++r)
+    {
+
+        double east, north;
+
+        m_windFrame.toEnu(fleet.regions[r].originLatitude(), fleet.regions[r].originLongitude(), east, north);
+
+        m_regionEast.push_back(east);
+
+        m_regionNorth.push_back(north);
+    }
+}
+
+PointMassStrategy::Body PointMassStrategy::bodyFrom(double speed, double heading, int battery) const
+{
+
+    const double rad = heading * FastTrig::DEG_TO_RAD;
+
+    double s, c;
+
+    FastTrig::sinCos(rad, s, c);
+
+    Body b;
+
+    b.velNorth = speed * c;
+
+    b.velEast = speed * s;
+
+    b.velUp = 0.0;
+
+    b.energyWh = std::max(0, battery) * 0.01 * m_config.batteryCapacityWh;
+
+    b.course = rad;
+
+    return b;
+}
+
+void PointMassStrategy::integrate(Body &b, double &east, double &north, double &altitude,
+                                  double &speed, double &heading, int &battery,
+                                  double windEast, double windNorth, double windUp, double noise, double dt) const
+{
+
+    const PointMassConfig &c = m_config;
+
+    const bool depleted = b.energyWh <= 0.0;
+
+    // commanded velocity: cruise along a wandering course, climb towards the target altitude
+    // (an empty battery means a straight controlled descent)
+
+    b.course += noise * c.headingWanderDeg * FastTrig::DEG_TO_RAD * std::sqrt(dt);
+
+    const double cruise = depleted ? 0.0 : c.cruiseSpeed;
+
+    double courseSin, courseCos;
+
+    FastTrig::sinCos(b.course, courseSin, courseCos);
+
+    const double cmdNorth = cruise * courseCos;
+
+    const double cmdEast = cruise * courseSin;
+
+    const double cmdUp = depleted ? -1.0 : std::clamp(c.altitudeGain * (c.targetAltitude - altitude), -c.maxClimbRate, c.maxClimbRate);
+
+    // quadratic drag on air-relative velocity
+
+    const double airNorth = b.velNorth - windNorth;
+
+    const double airEast = b.velEast - windEast;
+
+    const double airUp = b.velUp - windUp;
+
+    const double airSpeed = std::sqrt(airNorth * airNorth + airEast * airEast + airUp * airUp);
+
+    const double dragNorth = -c.dragPerMeter * airSpeed * airNorth;
+
+    const double dragEast = -c.dragPerMeter * airSpeed * airEast;
+
+    const double dragUp = -c.dragPerMeter * airSpeed * airUp;
+
+    // autopilot thrust: close the velocity error in responseTime while cancelling drag, saturated
+
+    double thrustNorth = (cmdNorth - b.velNorth) / c.responseTime - dragNorth;
+
+    double thrustEast = (cmdEast - b.velEast) / c.responseTime - dragEast;
+
+    const double thrustH = std::sqrt(thrustNorth * thrustNorth + thrustEast * thrustEast);
+
+    if (thrustH > c.maxAccel)
+    {
+
+        thrustNorth *= c.maxAccel / thrustH;
+
+        thrustEast *= c.maxAccel / thrustH;
+    }
+
+    const double thrustUp = std::clamp((cmdUp - b.velUp) / c.responseTime - dragUp, -c.maxVerticalAccel, c.maxVerticalAccel);
+
+    // semi-implicit Euler
+
+    b.velNorth += (thrustNorth + dragNorth) * dt;
+
+    b.velEast += (thrustEast + dragEast) * dt;
+
+    b.velUp += (thrustUp + dragUp) * dt;
+
+    north += b.velNorth * dt;
+
+    east += b.velEast * dt;
+
+    altitude += b.velUp * dt;
+
+    if (altitude <= 0.0)
+    {
+
+        // landed
+
+        altitude = 0.0;
+
+        b.velUp = std::max(0.0, b.velUp);
+    }
+
+    speed = std::sqrt(b.velNorth * b.velNorth + b.velEast * b.velEast);
+
+    heading = FastTrig::atan2(b.velEast, b.velNorth) * FastTrig::RAD_TO_DEG;
+
+    if (heading < 0.0)
+        heading += 360.0;
+
+    // power model: hover + parasitic (cubic in horizontal airspeed) + climb work
+
+    const double airH2 = airNorth * airNorth + airEast * airEast;
+
+    const double power = c.hoverPowerW + c.parasitePowerCoeff * airH2 * std::sqrt(airH2) + c.massKg * GRAVITY * std::max(0.0, b.velUp) / c.climbEfficiency;
+
+    b.energyWh = std::max(0.0, b.energyWh - power * dt / 3600.0);
+
+    battery = int(std::ceil(100.0 * b.energyWh / c.batteryCapacityWh));
+}
+
+TelemetrySnapshot PointMassStrategy::step(const TelemetrySnapshot &current, double dt)
+{
+
+    TelemetrySnapshot next = current;
+
+    Body body = bodyFrom(current.speed, current.heading, current.battery);
+
+    // the snapshot path has no region: work in the wind grid's own frame
+
+    double east, north, windEast = 0.0, windNorth = 0.0, windUp = 0.0;
+
+    m_windFrame.toEnu(current.latitude, current.longitude, east, north);
+
+    if (m_wind)
+        m_wind->sample(east, north, current.altitude, windEast, windNorth, windUp);
+
+    integrate(body, east, north, next.altitude, next.speed, next.heading, next.battery,
+              windEast, windNorth, windUp, m_rng.gaussian(), dt);
+
+    m_windFrame.toGeodetic(east, north, next.latitude, next.longitude);
+
+    return next;
+}
+
+void PointMassStrategy::stepBatch(FleetState &fleet, const std::vector<int> &members, double dt)
+{
+
+    const int n = int(members.size());
+
+    // grow per-drone columns and scratch only when the fleet grows; scratch is sized for the whole
+    // fleet so a batch growing after strategy switches never allocates in the tick
+
+    if (int(m_bodies.size()) < fleet.size())
+    {
+
+        m_bodies.resize(fleet.size());
+
+        m_writtenSpeed.resize(fleet.size(), 0.0);
+
+        m_writtenBattery.resize(fleet.size(), 0);
+
+        m_known.resize(fleet.size(), 0);
+    }
+
+    if (int(m_east.size()) < fleet.size())
+    {
+
+        for (std::vector<double> *v : {&m_east, &m_north, &m_up, &m_windEast, &m_windNorth, &m_windUp, &m_noise})
+            v->resize(fleet.size());
+    }
+
+    syncRegions(fleet);
+
+    // pass 1: resync bodies changed from outside, gather local positions
+
+    for (int k = 0; k < n; ++k)
+    {
+
+        const int i = members[k];
+
+        Body &b = m_bodies[i];
+
+        if (!m_known[i] || fleet.speed[i] != m_writtenSpeed[i])
+        {
+
+            // first step, speed override or another strategy moved the drone
+
+            const double keepUp = m_known[i] ? b.velUp : 0.0;
+
+            const double energy = b.energyWh;
+
+            b = bodyFrom(fleet.speed[i], fleet.heading[i], fleet.battery[i]);
+
+            b.velUp = keepUp;
+
+            if (m_known[i] && fleet.battery[i] == m_writtenBattery[i])
+                b.energyWh = energy;
+        }
+        else if (fleet.battery[i] != m_writtenBattery[i])
+        {
+
+            // battery changed outside (fault injection): follow it
+
+            b.energyWh = std::max(0, fleet.battery[i]) * 0.01 * m_config.batteryCapacityWh;
+        }
+
+        // region-relative ENU -> wind grid: one add per axis
+
+        m_east[k] = fleet.east[i] + m_regionEast[fleet.region[i]];
+
+        m_north[k] = fleet.north[i] + m_regionNorth[fleet.region[i]];
+
+        m_up[k] = fleet.altitude[i];
+    }
+
+    // pass 2: wind for the whole batch (SIMD trilinear lookups)
+
+    if (m_wind)
+    {
+
+        m_wind->sampleBatch(m_east.data(), m_north.data(), m_up.data(), n, m_windEast.data(), m_windNorth.data(), m_windUp.data());
+    }
+    else
+    {
+
+        std::fill_n(m_windEast.begin(), n, 0.0);
+
+        std::fill_n(m_windNorth.begin(), n, 0.0);
+
+        std::fill_n(m_windUp.begin(), n, 0.0);
+    }
+
+    m_rng.fillGaussian(m_noise.data(), n);
+
+    // pass 3: integrate
+
+    for (int k = 0; k < n; ++k)
+    {
+
+        const int i = members[k];
+
+        integrate(m_bodies[i], fleet.east[i], fleet.north[i], fleet.altitude[i],
+                  fleet.speed[i], fleet.heading[i], fleet.battery[i],
+                  m_windEast[k], m_windNorth[k], m_windUp[k], m_noise[k], dt);
+
+        m_writtenSpeed[i] = fleet.speed[i];
+
+        m_writtenBattery[i] = fleet.battery[i];
+
+        m_known[i] = 1;
+    }
+}
@@ -0,0 +1,104 @@
+/******************************************************************************
+ * PointMassStrategy.h
+ * Author: Jatin Kumawat
+ * Date: 19-10-2026
+ *
+ * Description:
+ *   Flight-dynamics movement strategy for drone simulation.
+ *
+ *   - Integrates acceleration-limited point-mass motion (inertia, quadratic
+ *  drag on airspeed, climb/descent towards a target altitude)
+ *   - Wind comes from a shared, precomputed 3D WindField sampled in batch
+ *   - Battery drain follows a power model (hover + parasitic + climb power)
+ *  instead of a fixed per-tick term
+ *   - Integrates directly on FleetState's ENU columns; region origins are
+ *  mapped into the wind grid with a per-region offset
+ ******************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include "MovementStrategy.h"
+#include "WindField.h"
+#include "FastRandom.h"
+
+// Vehicle and autopilot parameters.
+struct PointMassConfig
+{
+    double cruiseSpeed = 8.0;           // Commanded ground speed (m/s).
+    double headingWanderDeg = 6.0;      // Random walk of the commanded course (deg per sqrt(s)).
+    double targetAltitude = 60.0;       // Commanded altitude (meters).
+    double altitudeGain = 0.5;          // Climb-rate command per meter of altitude error (1/s).
+    double maxClimbRate = 3.0;          // Climb/descent rate limit (m/s).
+    double maxAccel = 4.0;              // Horizontal thrust acceleration limit (m/s^2).
+    double maxVerticalAccel = 2.0;      // Vertical thrust acceleration limit (m/s^2).
+    double responseTime = 1.0;          // Autopilot velocity time constant (s).
+    double dragPerMeter = 0.02;         // Quadratic drag: a = -k * |v_air| * v_air (1/m).
+    double massKg = 1.5;                // Take-off mass.
+    double hoverPowerW = 180.0;         // Electrical power needed to hover.
+    double parasitePowerCoeff = 0.05;   // Extra power per (m/s)^3 of horizontal airspeed.
+    double climbEfficiency = 0.7;       // Fraction of electrical power turned into climb work.
+    double batteryCapacityWh = 75.0;    // Usable energy of a full battery.
+};
+
+// Implements a strategy where drones fly as point masses through a wind field.
+class PointMassStrategy : public MovementStrategy
+{
+public:
+    explicit PointMassStrategy(std::shared_ptr<const WindField> wind = nullptr,
+                               const PointMassConfig &config = PointMassConfig(),
+                               std::uint64_t seed = 0xD1A11ull);
+
+    // Single-drone step: velocity is re-derived from speed/heading (no vertical inertia).
+    TelemetrySnapshot step(const TelemetrySnapshot &current, double dt) override;
+
+    // Batched step keeping full 3D velocity and battery energy per drone.
+    void stepBatch(FleetState &fleet, const std::vector<int> &members, double dt) override;
+
+    bool modelsBattery() const override { return true; }
+
+private:
+    // Dynamic state not present in TelemetrySnapshot.
+    struct Body
+    {
+        double velNorth, velEast, velUp; // Ground velocity (m/s).
+        double energyWh;                 // Remaining battery energy.
+        double course;                   // Commanded course (radians).
+    };
+
+    // Advances one body by dt with the given wind and course noise (position in ENU meters).
+    void integrate(Body &body, double &east, double &north, double &altitude,
+                   double &speed, double &heading, int &battery,
+                   double windEast, double windNorth, double windUp, double noise, double dt) const;
+
+    // Body matching a snapshot when no history is known.
+    Body bodyFrom(double speed, double heading, int battery) const;
+
+    // Refreshes the wind-grid offsets of the fleet's region origins when regions are added.
+    void syncRegions(const FleetState &fleet);
+
+    std::shared_ptr<const WindField> m_wind; // Shared read-only wind grid (may be null: calm air).
+
+    PointMassConfig m_config; // Vehicle parameters.
+
+    FastRandom m_rng; // Course wander noise.
+
+    EnuFrame m_windFrame; // Frame of the wind grid origin.
+
+    // --- Per-region offsets of the region origin in the wind frame (meters) ---
+    std::vector<double> m_regionEast;
+    std::vector<double> m_regionNorth;
+
+    // --- Per-drone columns, indexed like FleetState ---
+    std::vector<Body> m_bodies;           // Dynamic state.
+    std::vector<double> m_writtenSpeed;   // Speed written last step (detects overrides/strategy switches).
+    std::vector<int> m_writtenBattery;    // Battery written last step (detects external drains).
+    std::vector<std::uint8_t> m_known;    // 1 once the drone has been stepped by this strategy.
+
+    // --- Scratch, sized to the largest batch ---
+    std::vector<double> m_east, m_north, m_up;
+    std::vector<double> m_windEast, m_windNorth, m_windUp;
+    std::vector<double> m_noise;
+};
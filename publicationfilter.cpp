@@ -0,0 +1,170 @@
+#include "PublicationFilter.h"
+
+#include <algorithm>
+
+#include <cmath>
+
+DeadbandConfig DeadbandConfig::passThrough()
+{
+
+    DeadbandConfig c;
+
+    c.positionMeters = 0.0;
+
+    c.altitudeMeters = 0.0;
+
+    c.headingDegrees = 0.0;
+
+    c.speedMps = 0.0;
+
+    c.batteryPercent = 0;
+
+    c.heartbeatMs = 0;
+
+    return c;
+}
+
+void PublicationFilter::resize(int droneCount)
+{
+
+    m_pass.resize(droneCount, 1);
+
+    m_east.resize(droneCount, 0.0);
+
+    m_north.resize(droneCount, 0.0);
+
+    m_altitude.resize(droneCount, 0.0);
+
+    m_heading.resize(droneCount, 0.0);
+
+    m_speed.resize(droneCount, 0.0);
+
+    m_battery.resize(droneCount, 0);
+
+    m_gpsFix.resize(droneCount, 0);
+
+    m_region.resize(droneCount, -1);
+
+    m_lastMs.resize(droneCount, NEVER);
+}
+
+int PublicationFilter::evaluate(const FleetState &fleet, qint64 nowMs, const std::uint8_t *linkLost,
+                                const TelemetrySnapshot *published)
+{
+
+    const int n = std::min(fleet.size(), int(m_pass.size()));
+
+    const double position2 = m_config.positionMeters * m_config.positionMeters;
+
+    const double altitude = m_config.altitudeMeters;
+
+    const double heading = m_config.headingDegrees;
+
+    const double speed = m_config.speedMps;
+
+    const int battery = m_config.batteryPercent;
+
+    // a drone that never published has m_lastMs = NEVER, so the heartbeat always fires for it
+
+    const qint64 silentBefore = nowMs - std::max<qint64>(m_config.heartbeatMs, 0);
+
+    int passing = 0;
+
+    int active = 0;
+
+    // one branch-free pass: every test is evaluated and or-ed together
+
+    for (int i = 0; i < n; ++i)
+    {
+
+        // receivers see the noisy, faulted position: a bias onset or noise jump is a change for them
+
+        double east = fleet.east[i], north = fleet.north[i], up = fleet.altitude[i];
+
+        if (published)
+        {
+
+            fleet.regions[fleet.region[i]].toEnu(published[i].latitude, published[i].longitude, east, north);
+
+            up = published[i].altitude;
+        }
+
+        const double de = east - m_east[i];
+
+        const double dn = north - m_north[i];
+
+        double dh = std::fabs(fleet.heading[i] - m_heading[i]);
+
+        dh = std::min(dh, 360.0 - dh);
+
+        const bool changed = (de * de + dn * dn >= position2)
+                             | (std::fabs(up - m_altitude[i]) >= altitude)
+                             | (dh >= heading)
+                             | (std::fabs(fleet.speed[i] - m_speed[i]) >= speed)
+                             | (std::abs(fleet.battery[i] - m_battery[i]) >= battery)
+                             | (std::uint8_t(fleet.gpsFix[i]) != m_gpsFix[i])
+                             | (fleet.region[i] != m_region[i])
+                             | (m_lastMs[i] <= silentBefore);
+
+        // a drone that cannot send is neither published nor suppressed
+
+        const bool running = (fleet.paused[i] == 0) & !(linkLost && linkLost[i]);
+
+        m_pass[i] = std::uint8_t(changed & running);
+
+        // receivers saw it go silent: once it can send again it is announced even if unchanged
+
+        m_lastMs[i] = running ? m_lastMs[i] : NEVER;
+
+        passing += m_pass[i];
+
+        active += running;
+    }
+
+    m_evaluated += std::uint64_t(active);
+
+    m_suppressed += std::uint64_t(active - passing);
+
+    return passing;
+}
+
+void PublicationFilter::markPublished(const FleetState &fleet, int i, qint64 nowMs, const TelemetrySnapshot *published)
+{
+
+    if (published)
+    {
+
+        fleet.regions[fleet.region[i]].toEnu(published->latitude, published->longitude, m_east[i], m_north[i]);
+
+        m_altitude[i] = published->altitude;
+    }
+    else
+    {
+
+        m_east[i] = fleet.east[i];
+
+        m_north[i] = fleet.north[i];
+
+        m_altitude[i] = fleet.altitude[i];
+    }
+
+    m_heading[i] = fleet.heading[i];
+
+    m_speed[i] = fleet.speed[i];
+
+    m_battery[i] = fleet.battery[i];
+
+    m_gpsFix[i] = std::uint8_t(fleet.gpsFix[i]);
+
+    m_region[i] = fleet.region[i];
+
+    m_lastMs[i] = nowMs;
+}
+
+void PublicationFilter::resetStatistics()
+{
+
+    m_evaluated = 0;
+
+    m_suppressed = 0;
+}
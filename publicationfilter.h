@@ -0,0 +1,97 @@
+/******************************************************************************
+ * PublicationFilter.h
+ * Author: Jatin Kumawat
+ * Date: 19-10-2026
+ *
+ * Description:
+ *   Deadband (change-based) filter deciding which drones publish a record
+ *   this tick.
+ *
+ *   - A drone publishes when any field moved past its deadband since its
+ *  last published record, its fix quality changed, or the heartbeat
+ *  interval elapsed (so receivers can tell "unchanged" from "gone")
+ *   - Evaluated in batch over the columnar fleet state, one pass per tick,
+ *  against columns holding every drone's last published values
+ *   - Given the outgoing snapshots, compares what receivers actually get
+ *  (position and altitude after GPS noise and sensor faults)
+ *   - Keeps suppression statistics
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "FleetState.h"
+
+// Per-field deadbands. A change equal to or larger than the deadband publishes;
+// all zeros publish every tick.
+struct DeadbandConfig
+{
+    double positionMeters = 1.0;  // Horizontal distance.
+    double altitudeMeters = 0.5;
+    double headingDegrees = 2.0;  // Shortest angle, across 0/360.
+    double speedMps = 0.25;
+    int batteryPercent = 1;
+    qint64 heartbeatMs = 5000;    // Maximum silence of a drone; <= 0 publishes every tick.
+
+    static DeadbandConfig passThrough(); // Publishes every record (no filtering).
+};
+
+class PublicationFilter
+{
+public:
+    void setConfig(const DeadbandConfig &config) { m_config = config; } // Call before start().
+
+    const DeadbandConfig &config() const { return m_config; } // Current deadbands.
+
+    // Grows the per-drone columns to match the fleet. Call whenever drones are added.
+    void resize(int droneCount);
+
+    // Decides for every drone whether it publishes at nowMs. Paused drones never do, nor drones
+    // whose linkLost flag (one per drone, optional) is set; neither counts in the statistics, and
+    // both publish at the first evaluate() after they resume or their link is restored.
+    // published (one per drone, optional) holds each running drone's outgoing snapshot; its position
+    // and altitude are compared instead of the fleet's true ones. Returns the number of drones that pass. Tick thread only.
+    int evaluate(const FleetState &fleet, qint64 nowMs, const std::uint8_t *linkLost = nullptr,
+                 const TelemetrySnapshot *published = nullptr);
+
+    bool passes(int i) const { return m_pass[i] != 0; } // Result of the last evaluate() for drone i.
+
+    // Records that drone i published its current row (the reference for the next deadband checks),
+    // with the position and altitude of published if given (the snapshot passed to evaluate()).
+    void markPublished(const FleetState &fleet, int i, qint64 nowMs, const TelemetrySnapshot *published = nullptr);
+
+    // Forces drone i to publish at the next evaluate() (e.g. when an operator resumes it).
+    void invalidate(int i) { m_lastMs[i] = NEVER; }
+
+    // --- statistics (since construction or resetStatistics()) ---
+
+    std::uint64_t evaluated() const { return m_evaluated; } // Drone-ticks considered.
+
+    std::uint64_t suppressed() const { return m_suppressed; } // Drone-ticks filtered out.
+
+    double suppressionRatio() const { return m_evaluated ? double(m_suppressed) / double(m_evaluated) : 0.0; }
+
+    void resetStatistics();
+
+private:
+    static constexpr qint64 NEVER = INT64_MIN / 2; // Last publication of a drone that never published.
+
+    DeadbandConfig m_config; // Deadbands and heartbeat.
+
+    std::vector<std::uint8_t> m_pass; // 1 = publishes this tick.
+
+    // Last published row, same units as FleetState.
+    std::vector<double> m_east;
+    std::vector<double> m_north;
+    std::vector<double> m_altitude;
+    std::vector<double> m_heading;
+    std::vector<double> m_speed;
+    std::vector<int> m_battery;
+    std::vector<std::uint8_t> m_gpsFix;
+    std::vector<int> m_region;
+    std::vector<qint64> m_lastMs;
+
+    std::uint64_t m_evaluated = 0;
+    std::uint64_t m_suppressed = 0;
+};
@@ -4,6 +4,8 @@
 
 #include <QRandomGenerator>
 
+#include "FastTrig.h"
+
 static constexpr double DEG_PER_METER = 1.0 / 111320.0;
 
 TelemetrySnapshot RandomWalkStrategy::step(const TelemetrySnapshot &current, double dt)
@@ -27,11 +29,13 @@ TelemetrySnapshot RandomWalkStrategy::step(const TelemetrySnapshot &current, dou
 
     double dist = next.speed * dt;
 
-    double rad = next.heading * M_PI / 180.0;
+    double s, c;
+
+    FastTrig::sinCos(next.heading * FastTrig::DEG_TO_RAD, s, c);
 
-    double dy = cos(rad) * dist;
+    double dy = c * dist;
 
-    double dx = sin(rad) * dist;
+    double dx = s * dist;
 
     next.latitude += dy * DEG_PER_METER;
 
@@ -46,4 +50,38 @@ TelemetrySnapshot RandomWalkStrategy::step(const TelemetrySnapshot &current, dou
     next.altitude += randRange(-0.2, 0.5) * dt;
 
     return next;
-}
\ No newline at end of file
+}
+
+void RandomWalkStrategy::stepBatch(FleetState &fleet, const std::vector<int> &members, double dt)
+{
+
+    for (int i : members)
+    {
+
+        // heading change (-15 to +15 deg)
+
+        double heading = fmod(fleet.heading[i] + randRange(-15.0, 15.0) * dt + 360.0, 360.0);
+
+        double speed = std::max(0.0, fleet.speed[i] + randRange(-1.0, 1.5) * dt);
+
+        // move in meters: no cos(latitude) per drone
+
+        double dist = speed * dt;
+
+        double s, c;
+
+        FastTrig::sinCos(heading * FastTrig::DEG_TO_RAD, s, c);
+
+        fleet.north[i] += c * dist;
+
+        fleet.east[i] += s * dist;
+
+        fleet.heading[i] = heading;
+
+        fleet.speed[i] = speed;
+
+        fleet.battery[i] = std::max(0, fleet.battery[i] - (int)(dt * (0.05 + speed * 0.01)));
+
+        fleet.altitude[i] += randRange(-0.2, 0.5) * dt;
+    }
+}
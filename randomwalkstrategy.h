@@ -23,4 +23,7 @@ class RandomWalkStrategy : public MovementStrategy
 public:
     // Calculates and returns the next telemetry snapshot based on random movement and heading changes.
     TelemetrySnapshot step(const TelemetrySnapshot &current, double dt) override;
+
+    // Same walk applied directly to the fleet's ENU columns (no lat/lon round trip).
+    void stepBatch(FleetState &fleet, const std::vector<int> &members, double dt) override;
 };
\ No newline at end of file
@@ -6,29 +6,68 @@
 
 #include "RandomWalkStrategy.h"
 
+#include "PointMassStrategy.h"
+
+#include "FormationStrategy.h"
+
 #include "Logger.h"
 
+void SimulatorFactory::registerBuiltinStrategies(DroneSimulator *sim)
+{
+
+    // one shared instance per type: switching strategy at runtime is then just an index change
+
+    sim->registerStrategy(StrategyType::Hover, std::make_unique<HoverStrategy>());
+
+    sim->registerStrategy(StrategyType::RandomWalk, std::make_unique<RandomWalkStrategy>());
+
+    // the wind grid is built once and could be shared by several strategies
+
+    auto wind = std::make_shared<const WindField>(WindFieldConfig());
+
+    sim->registerStrategy(StrategyType::PointMass, std::make_unique<PointMassStrategy>(wind));
+
+    sim->registerStrategy(StrategyType::Formation, std::make_unique<FormationStrategy>());
+}
+
+static int validStrategy(int strategyType)
+{
+
+    return strategyType >= 0 && strategyType < StrategyType::Count ? strategyType : int(StrategyType::Hover);
+}
+
 DroneSimulator *SimulatorFactory::createSingleDroneSimulator(const QString &droneId, int strategyType, QObject *parent)
 {
 
     DroneSimulator *sim = new DroneSimulator(droneId, parent);
 
-    std::unique_ptr<MovementStrategy> strat;
+    registerBuiltinStrategies(sim);
 
-    if (strategyType == StrategyType::RandomWalk)
-    {
+    sim->addDrone(droneId, 0, validStrategy(strategyType));
 
-        strat = std::make_unique<RandomWalkStrategy>();
-    }
-    else
+    Logger::instance().log(QString("Factory: Created simulator %1 with strategy %2").arg(droneId).arg(strategyType));
+
+    return sim;
+}
+
+DroneSimulator *SimulatorFactory::createFleetSimulator(const QString &idPrefix, int droneCount, int groupSize, int strategyType, QObject *parent)
+{
+
+    DroneSimulator *sim = new DroneSimulator(idPrefix, parent);
+
+    registerBuiltinStrategies(sim);
+
+    const int strat = validStrategy(strategyType);
+
+    const int perGroup = std::max(1, groupSize);
+
+    for (int i = 0; i < droneCount; ++i)
     {
 
-        strat = std::make_unique<HoverStrategy>();
+        sim->addDrone(QString("%1-%2").arg(idPrefix).arg(i + 1, 4, 10, QChar('0')), i / perGroup, strat);
     }
 
-    sim->setStrategy(std::move(strat));
-
-    Logger::instance().log(QString("Factory: Created simulator %1 with strategy %2").arg(droneId).arg(strategyType));
+    Logger::instance().log(QString("Factory: Created fleet %1 with %2 drones, strategy %3").arg(idPrefix).arg(droneCount).arg(strategyType));
 
     return sim;
-}
\ No newline at end of file
+}
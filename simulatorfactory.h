@@ -11,7 +11,10 @@ namespace StrategyType
     enum Type
     {
         Hover = 0,     // Strategy for keeping the drone nearly stationary.
-        RandomWalk = 1 // Strategy for making the drone wander randomly.
+        RandomWalk = 1, // Strategy for making the drone wander randomly.
+        PointMass = 2,  // Strategy flying the drone as a point mass through a wind field.
+        Formation = 3,  // Strategy holding a grid slot behind the group's leader.
+        Count           // Number of built-in strategies (not a strategy).
     };
 }
 
@@ -21,4 +24,11 @@ class SimulatorFactory
 public:
     // Static method: Creates a DroneSimulator instance with the specified ID and movement strategy.
     static DroneSimulator *createSingleDroneSimulator(const QString &droneId, int strategyType, QObject *parent = nullptr);
+
+    // Static method: Creates a simulator driving droneCount drones named "<idPrefix>-0001"...,
+    // split into consecutive groups of groupSize drones (group ids 0, 1, 2, ...).
+    static DroneSimulator *createFleetSimulator(const QString &idPrefix, int droneCount, int groupSize, int strategyType, QObject *parent = nullptr);
+
+    // Registers one instance of every built-in strategy on the simulator (for fleets built drone by drone).
+    static void registerBuiltinStrategies(DroneSimulator *sim);
 };
\ No newline at end of file
@@ -0,0 +1,106 @@
+/******************************************************************************
+ * TelemetryBus.h
+ * Author: Jatin Kumawat
+ * Date: 19-10-2026
+ *
+ * Description:
+ *   Memory layout of the shared-memory telemetry bus.
+ *
+ *   - One POSIX shared-memory object per simulator, written by
+ *  TelemetryBusWriter and mapped read-only by any number of
+ *  TelemetryBusReader processes
+ *   - Two frame buffers: the writer fills the one readers are not looking
+ *  at, then publishes its frame number; each buffer carries a seqlock
+ *  counter so a reader that was overtaken can detect it and retry
+ *   - Columnar frames (one array per field) with fixed offsets derived
+ *  from the capacity, so readers can use the columns in place
+ *   - Plain C++ with no Qt dependency, shared by the writer and readers
+ ******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace TelemetryBus
+{
+    constexpr std::uint32_t MAGIC = 0x424D4C54;  // "TLMB" in memory.
+    constexpr std::uint32_t VERSION = 2;         // Bumped on any layout change.
+    constexpr std::uint32_t ID_BYTES = 16;       // Drone id, UTF-8, NUL-padded (truncated if longer).
+    constexpr std::size_t ALIGNMENT = 64;        // Every block and column starts on a cache line.
+
+    // Bits of the flags column.
+    enum Flags : std::uint8_t
+    {
+        Live = 1,     // Row holds this frame's telemetry.
+        Paused = 2,   // Drone is paused; other columns are stale.
+        LinkLost = 4  // Telemetry link is down; other columns are stale.
+    };
+
+    // Start of the shared object. Written once by the writer, except latestFrame.
+    struct alignas(ALIGNMENT) RegionHeader
+    {
+        std::atomic<std::uint32_t> magic; // MAGIC once the region is fully initialized.
+        std::uint32_t version;            // VERSION of the writer.
+        std::uint32_t capacity;           // Maximum number of drones per frame.
+        std::uint32_t idBytes;            // ID_BYTES of the writer.
+        std::uint64_t regionBytes;        // Total size of the shared object.
+        std::uint64_t idsOffset;          // Offset of the id table (capacity * idBytes).
+        std::uint64_t bufferOffset;       // Offset of buffer 0.
+        std::uint64_t bufferBytes;        // Size of one buffer; buffer 1 follows buffer 0.
+        std::int64_t writerPid;           // Process id of the writer, to tell a live region from a leftover one.
+
+        alignas(ALIGNMENT) std::atomic<std::uint64_t> latestFrame; // Newest committed frame (0 = none yet); lives in buffer latestFrame & 1.
+    };
+
+    // Start of each frame buffer, followed by the columns.
+    struct alignas(ALIGNMENT) BufferHeader
+    {
+        std::atomic<std::uint64_t> sequence; // Seqlock: odd while the writer is filling the buffer.
+        std::uint64_t frame;                 // Frame number stored in the buffer.
+        std::int64_t timestampMs;            // Simulation time of the frame (ms since epoch).
+        std::uint32_t count;                 // Rows in the frame.
+    };
+
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "the bus needs address-free 64-bit atomics");
+
+    // Column offsets inside a buffer, relative to the buffer start.
+    struct Layout
+    {
+        std::uint64_t latitude, longitude, altitude, heading, speed; // double[capacity]
+        std::uint64_t timestampMs;                                   // int64[capacity]
+        std::uint64_t battery;                                       // int32[capacity]
+        std::uint64_t gpsFix, flags;                                 // uint8[capacity]
+        std::uint64_t bufferBytes;                                   // Total size of one buffer.
+    };
+
+    inline std::uint64_t alignUp(std::uint64_t n)
+    {
+        return (n + ALIGNMENT - 1) & ~std::uint64_t(ALIGNMENT - 1);
+    }
+
+    // Buffer layout for a given capacity (identical in the writer and every reader).
+    inline Layout layoutFor(std::uint32_t capacity)
+    {
+        Layout l;
+        std::uint64_t at = alignUp(sizeof(BufferHeader));
+        auto column = [&](std::uint64_t elementBytes)
+        {
+            const std::uint64_t offset = at;
+            at = alignUp(at + elementBytes * capacity);
+            return offset;
+        };
+        l.latitude = column(sizeof(double));
+        l.longitude = column(sizeof(double));
+        l.altitude = column(sizeof(double));
+        l.heading = column(sizeof(double));
+        l.speed = column(sizeof(double));
+        l.timestampMs = column(sizeof(std::int64_t));
+        l.battery = column(sizeof(std::int32_t));
+        l.gpsFix = column(sizeof(std::uint8_t));
+        l.flags = column(sizeof(std::uint8_t));
+        l.bufferBytes = at;
+        return l;
+    }
+}
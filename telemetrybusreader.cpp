@@ -0,0 +1,259 @@
+#include "TelemetryBusReader.h"
+
+#include <algorithm>
+
+#include <cerrno>
+
+#include <cstring>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define TELEMETRYBUS_POSIX 1
+#endif
+
+using namespace TelemetryBus;
+
+static bool fail(std::string *error, const std::string &message)
+{
+
+    if (error)
+        *error = message;
+
+    return false;
+}
+
+TelemetryBusReader::~TelemetryBusReader()
+{
+
+    close();
+}
+
+bool TelemetryBusReader::open(const std::string &name, std::string *error)
+{
+
+    close();
+
+#ifdef TELEMETRYBUS_POSIX
+
+    const int fd = shm_open(name.c_str(), O_RDONLY, 0);
+
+    if (fd < 0)
+        return fail(error, "shm_open(" + name + ") failed: " + std::strerror(errno));
+
+    struct stat st;
+
+    if (fstat(fd, &st) != 0 || std::uint64_t(st.st_size) < sizeof(RegionHeader))
+    {
+
+        ::close(fd);
+
+        return fail(error, name + " is not a telemetry bus (too small)");
+    }
+
+    void *mapping = mmap(nullptr, std::size_t(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+
+    const int err = errno;
+
+    ::close(fd);
+
+    if (mapping == MAP_FAILED)
+        return fail(error, "mmap(" + name + ") failed: " + std::strerror(err));
+
+    const auto *h = static_cast<const RegionHeader *>(mapping);
+
+    // magic is stored last by the writer: once it matches, the header is complete
+
+    std::string problem;
+
+    if (h->magic.load(std::memory_order_acquire) != MAGIC)
+        problem = name + " is not a telemetry bus (or is still being created)";
+    else if (h->version != VERSION || h->idBytes != ID_BYTES)
+        problem = name + " was written by an incompatible simulator version";
+    else if (h->regionBytes > std::uint64_t(st.st_size) || layoutFor(h->capacity).bufferBytes != h->bufferBytes)
+        problem = name + " has an inconsistent layout";
+
+    if (!problem.empty())
+    {
+
+        munmap(mapping, std::size_t(st.st_size));
+
+        return fail(error, problem);
+    }
+
+    m_region = static_cast<const unsigned char *>(mapping);
+
+    m_regionBytes = std::uint64_t(st.st_size);
+
+    m_layout = layoutFor(h->capacity);
+
+    return true;
+
+#else
+
+    return fail(error, "shared-memory telemetry bus " + name + " needs a POSIX system");
+
+#endif
+}
+
+void TelemetryBusReader::close()
+{
+
+    if (!m_region)
+        return;
+
+#ifdef TELEMETRYBUS_POSIX
+
+    munmap(const_cast<unsigned char *>(m_region), m_regionBytes);
+
+#endif
+
+    m_region = nullptr;
+
+    m_regionBytes = 0;
+}
+
+std::uint32_t TelemetryBusReader::capacity() const
+{
+
+    return m_region ? header()->capacity : 0;
+}
+
+std::uint64_t TelemetryBusReader::latestFrame() const
+{
+
+    return m_region ? header()->latestFrame.load(std::memory_order_acquire) : 0;
+}
+
+bool TelemetryBusReader::acquire(FrameView &view) const
+{
+
+    const std::uint64_t frame = latestFrame();
+
+    if (frame == 0)
+        return false;
+
+    const unsigned char *base = m_region + header()->bufferOffset + (frame & 1) * header()->bufferBytes;
+
+    const auto *buffer = reinterpret_cast<const BufferHeader *>(base);
+
+    const std::uint64_t sequence = buffer->sequence.load(std::memory_order_acquire);
+
+    // odd: the writer has already lapped us and is refilling this buffer
+
+    if (sequence & 1)
+        return false;
+
+    view.frame = buffer->frame;
+
+    view.timestampMs = buffer->timestampMs;
+
+    view.count = std::min(buffer->count, header()->capacity);
+
+    view.latitude = reinterpret_cast<const double *>(base + m_layout.latitude);
+
+    view.longitude = reinterpret_cast<const double *>(base + m_layout.longitude);
+
+    view.altitude = reinterpret_cast<const double *>(base + m_layout.altitude);
+
+    view.heading = reinterpret_cast<const double *>(base + m_layout.heading);
+
+    view.speed = reinterpret_cast<const double *>(base + m_layout.speed);
+
+    view.rowTimestampMs = reinterpret_cast<const std::int64_t *>(base + m_layout.timestampMs);
+
+    view.battery = reinterpret_cast<const std::int32_t *>(base + m_layout.battery);
+
+    view.gpsFix = base + m_layout.gpsFix;
+
+    view.flags = base + m_layout.flags;
+
+    view.sequence = sequence;
+
+    view.buffer = base;
+
+    // the header fields above are covered by the same check
+
+    return validate(view);
+}
+
+bool TelemetryBusReader::validate(const FrameView &view) const
+{
+
+    if (!view.buffer)
+        return false;
+
+    // order every read made through the view before the re-check
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    const auto *buffer = static_cast<const BufferHeader *>(view.buffer);
+
+    return buffer->sequence.load(std::memory_order_relaxed) == view.sequence;
+}
+
+bool TelemetryBusReader::read(Frame &out, int maxAttempts) const
+{
+
+    FrameView view;
+
+    for (int attempt = 0; attempt < maxAttempts; ++attempt)
+    {
+
+        if (!acquire(view))
+        {
+
+            if (latestFrame() == 0)
+                return false;
+
+            continue;
+        }
+
+        const std::uint32_t n = view.count;
+
+        out.latitude.assign(view.latitude, view.latitude + n);
+
+        out.longitude.assign(view.longitude, view.longitude + n);
+
+        out.altitude.assign(view.altitude, view.altitude + n);
+
+        out.heading.assign(view.heading, view.heading + n);
+
+        out.speed.assign(view.speed, view.speed + n);
+
+        out.rowTimestampMs.assign(view.rowTimestampMs, view.rowTimestampMs + n);
+
+        out.battery.assign(view.battery, view.battery + n);
+
+        out.gpsFix.assign(view.gpsFix, view.gpsFix + n);
+
+        out.flags.assign(view.flags, view.flags + n);
+
+        if (validate(view))
+        {
+
+            out.frame = view.frame;
+
+            out.timestampMs = view.timestampMs;
+
+            out.count = n;
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+std::string TelemetryBusReader::id(int i) const
+{
+
+    if (!m_region || i < 0 || std::uint32_t(i) >= header()->capacity)
+        return std::string();
+
+    const char *slot = reinterpret_cast<const char *>(m_region + header()->idsOffset) + std::size_t(i) * ID_BYTES;
+
+    return std::string(slot, strnlen(slot, ID_BYTES));
+}
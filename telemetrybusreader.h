@@ -0,0 +1,96 @@
+/******************************************************************************
+ * TelemetryBusReader.h
+ * Author: Jatin Kumawat
+ * Date: 19-10-2026
+ *
+ * Description:
+ *   Consumer side of the shared-memory telemetry bus (see TelemetryBus.h).
+ *
+ *   - Maps the simulator's region read-only; any number of processes may
+ *  read at once and none of them can slow the writer
+ *   - acquire() / validate() give zero-copy access to the latest frame's
+ *  columns; read() copies a consistent frame for callers that keep it
+ *   - No Qt dependency: built as the small TelemetryBusReader library
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "TelemetryBus.h"
+
+class TelemetryBusReader
+{
+public:
+    // Zero-copy view of one frame. Columns point into the shared mapping and
+    // are only trustworthy if validate() returns true after they were read.
+    struct FrameView
+    {
+        std::uint64_t frame = 0;         // Frame number (increases by one per simulator tick).
+        std::int64_t timestampMs = 0;    // Simulation time of the frame.
+        std::uint32_t count = 0;         // Rows in the frame.
+        const double *latitude = nullptr;
+        const double *longitude = nullptr;
+        const double *altitude = nullptr;
+        const double *heading = nullptr;
+        const double *speed = nullptr;
+        const std::int64_t *rowTimestampMs = nullptr;
+        const std::int32_t *battery = nullptr;
+        const std::uint8_t *gpsFix = nullptr; // TelemetrySnapshot::GpsFix values.
+        const std::uint8_t *flags = nullptr;  // TelemetryBus::Flags bits.
+        std::uint64_t sequence = 0;           // Seqlock value seen by acquire().
+        const void *buffer = nullptr;         // Buffer the view refers to.
+    };
+
+    // Owned copy of one frame.
+    struct Frame
+    {
+        std::uint64_t frame = 0;
+        std::int64_t timestampMs = 0;
+        std::uint32_t count = 0;
+        std::vector<double> latitude, longitude, altitude, heading, speed;
+        std::vector<std::int64_t> rowTimestampMs;
+        std::vector<std::int32_t> battery;
+        std::vector<std::uint8_t> gpsFix, flags;
+    };
+
+    TelemetryBusReader() = default;
+
+    ~TelemetryBusReader(); // Unmaps the region.
+
+    TelemetryBusReader(const TelemetryBusReader &) = delete;
+    TelemetryBusReader &operator=(const TelemetryBusReader &) = delete;
+
+    // Maps an existing region ("/drone-telemetry"). On failure returns false and describes the reason in error (if given).
+    bool open(const std::string &name, std::string *error = nullptr);
+
+    void close(); // Unmaps the region.
+
+    bool isOpen() const { return m_region != nullptr; } // True between a successful open() and close().
+
+    std::uint32_t capacity() const; // Maximum drones per frame.
+
+    std::uint64_t latestFrame() const; // Newest committed frame number, 0 if none yet. Cheap enough to poll.
+
+    // Points view at the newest committed frame. Returns false if there is none yet
+    // or the writer is overwriting it right now (try again).
+    bool acquire(FrameView &view) const;
+
+    // True if the writer has not touched the view's buffer since acquire(),
+    // i.e. everything read through the view so far is consistent.
+    bool validate(const FrameView &view) const;
+
+    // Copies the newest frame into out, retrying up to maxAttempts times. Reuses out's storage.
+    bool read(Frame &out, int maxAttempts = 8) const;
+
+    // Id of row i (ids never change once a drone has appeared in a frame).
+    std::string id(int i) const;
+
+private:
+    const TelemetryBus::RegionHeader *header() const { return reinterpret_cast<const TelemetryBus::RegionHeader *>(m_region); }
+
+    const unsigned char *m_region = nullptr; // Start of the read-only mapping.
+    std::uint64_t m_regionBytes = 0;         // Size of the mapping.
+    TelemetryBus::Layout m_layout{};         // Column offsets inside a buffer.
+};
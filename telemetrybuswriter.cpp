@@ -0,0 +1,358 @@
+#include "TelemetryBusWriter.h"
+
+#include <algorithm>
+
+#include <cerrno>
+
+#include <cstring>
+
+#include <new>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define TELEMETRYBUS_POSIX 1
+#endif
+
+using namespace TelemetryBus;
+
+static bool fail(QString *error, const QString &message)
+{
+
+    if (error)
+        *error = message;
+
+    return false;
+}
+
+#ifdef TELEMETRYBUS_POSIX
+
+// True if the object shmName exists no more, or was left by a writer process that has exited.
+// writerPid receives the recorded writer (0 if the header is incomplete or of another version).
+static bool writerIsGone(const char *shmName, long long *writerPid)
+{
+
+    *writerPid = 0;
+
+    const int fd = shm_open(shmName, O_RDONLY, 0);
+
+    if (fd < 0)
+        return errno == ENOENT;
+
+    bool gone = false;
+
+    struct stat info;
+
+    if (fstat(fd, &info) == 0 && std::uint64_t(info.st_size) >= sizeof(RegionHeader))
+    {
+
+        void *mapping = mmap(nullptr, sizeof(RegionHeader), PROT_READ, MAP_SHARED, fd, 0);
+
+        if (mapping != MAP_FAILED)
+        {
+
+            const auto *header = static_cast<const RegionHeader *>(mapping);
+
+            // the pid is trusted only once the magic says the header is complete
+
+            if (header->magic.load(std::memory_order_acquire) == MAGIC && header->version == VERSION)
+                *writerPid = header->writerPid;
+
+            // EPERM means the process exists under another user
+
+            gone = *writerPid > 0 && kill(pid_t(*writerPid), 0) != 0 && errno == ESRCH;
+
+            munmap(mapping, sizeof(RegionHeader));
+        }
+    }
+
+    ::close(fd);
+
+    return gone;
+}
+
+#endif
+
+TelemetryBusWriter::~TelemetryBusWriter()
+{
+
+    close();
+}
+
+bool TelemetryBusWriter::open(const QString &name, std::uint32_t capacity, QString *error, bool replaceExisting)
+{
+
+    close();
+
+#ifdef TELEMETRYBUS_POSIX
+
+    const QByteArray shmName = name.toUtf8();
+
+    const Layout layout = layoutFor(capacity);
+
+    const std::uint64_t idsOffset = alignUp(sizeof(RegionHeader));
+
+    const std::uint64_t bufferOffset = alignUp(idsOffset + std::uint64_t(capacity) * ID_BYTES);
+
+    const std::uint64_t total = bufferOffset + 2 * layout.bufferBytes;
+
+    int fd = shm_open(shmName.constData(), O_CREAT | O_EXCL | O_RDWR, 0644);
+
+    if (fd < 0 && errno == EEXIST)
+    {
+
+        long long writerPid = 0;
+
+        if (!replaceExisting && !writerIsGone(shmName.constData(), &writerPid))
+        {
+
+            if (writerPid > 0)
+                return fail(error, QString("telemetry bus %1 is in use by process %2").arg(name).arg(writerPid));
+
+            return fail(error, QString("telemetry bus %1 already exists and its writer is unknown; remove it or open with replaceExisting").arg(name));
+        }
+
+        // a region left behind by a crashed writer is replaced; readers still mapping it keep their copy
+
+        shm_unlink(shmName.constData());
+
+        fd = shm_open(shmName.constData(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    }
+
+    if (fd < 0)
+        return fail(error, QString("shm_open(%1) failed: %2").arg(name).arg(QString(std::strerror(errno))));
+
+    struct stat info;
+
+    if (fstat(fd, &info) != 0)
+        info = {};
+
+    if (ftruncate(fd, off_t(total)) != 0)
+    {
+
+        const int err = errno;
+
+        ::close(fd);
+
+        shm_unlink(shmName.constData());
+
+        return fail(error, QString("ftruncate(%1) failed: %2").arg(name).arg(QString(std::strerror(err))));
+    }
+
+    void *mapping = mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+    const int err = errno;
+
+    ::close(fd);
+
+    if (mapping == MAP_FAILED)
+    {
+
+        shm_unlink(shmName.constData());
+
+        return fail(error, QString("mmap(%1) failed: %2").arg(name).arg(QString(std::strerror(err))));
+    }
+
+    // ftruncate zero-fills: ids are empty, both sequences are even and no frame is published
+
+    m_region = static_cast<unsigned char *>(mapping);
+
+    auto *header = new (m_region) RegionHeader;
+
+    header->version = VERSION;
+
+    header->capacity = capacity;
+
+    header->idBytes = ID_BYTES;
+
+    header->regionBytes = total;
+
+    header->idsOffset = idsOffset;
+
+    header->bufferOffset = bufferOffset;
+
+    header->bufferBytes = layout.bufferBytes;
+
+    header->writerPid = getpid();
+
+    header->latestFrame.store(0, std::memory_order_relaxed);
+
+    for (int b = 0; b < 2; ++b)
+        new (m_region + bufferOffset + b * layout.bufferBytes) BufferHeader;
+
+    // readers accept the region only once the magic is visible
+
+    header->magic.store(MAGIC, std::memory_order_release);
+
+    m_name = name;
+
+    m_regionBytes = total;
+
+    m_device = std::uint64_t(info.st_dev);
+
+    m_inode = std::uint64_t(info.st_ino);
+
+    m_capacity = capacity;
+
+    m_layout = layout;
+
+    m_frame = 0;
+
+    return true;
+
+#else
+
+    Q_UNUSED(capacity);
+
+    return fail(error, QString("shared-memory telemetry bus %1 needs a POSIX system").arg(name));
+
+#endif
+}
+
+void TelemetryBusWriter::close()
+{
+
+    if (!m_region)
+        return;
+
+#ifdef TELEMETRYBUS_POSIX
+
+    munmap(m_region, m_regionBytes);
+
+    // the name may meanwhile belong to a writer that replaced this one
+
+    const QByteArray shmName = m_name.toUtf8();
+
+    const int fd = shm_open(shmName.constData(), O_RDONLY, 0);
+
+    if (fd >= 0)
+    {
+
+        struct stat info;
+
+        if (fstat(fd, &info) == 0 && std::uint64_t(info.st_dev) == m_device && std::uint64_t(info.st_ino) == m_inode)
+            shm_unlink(shmName.constData());
+
+        ::close(fd);
+    }
+
+#endif
+
+    m_region = nullptr;
+
+    m_buffer = nullptr;
+
+    m_regionBytes = 0;
+
+    m_capacity = 0;
+}
+
+void TelemetryBusWriter::setId(int i, const QString &id)
+{
+
+    if (!m_region || i < 0 || std::uint32_t(i) >= m_capacity)
+        return;
+
+    const auto *header = reinterpret_cast<const RegionHeader *>(m_region);
+
+    char *slot = reinterpret_cast<char *>(m_region + header->idsOffset) + std::size_t(i) * ID_BYTES;
+
+    const QByteArray utf8 = id.toUtf8();
+
+    // always leave room for the terminating NUL
+
+    const std::size_t n = std::min<std::size_t>(utf8.size(), ID_BYTES - 1);
+
+    std::memset(slot, 0, ID_BYTES);
+
+    std::memcpy(slot, utf8.constData(), n);
+}
+
+void TelemetryBusWriter::beginFrame(int count, std::int64_t timestampMs)
+{
+
+    if (!m_region)
+        return;
+
+    const auto *header = reinterpret_cast<const RegionHeader *>(m_region);
+
+    const std::uint64_t frame = m_frame + 1;
+
+    // readers look at buffer (m_frame & 1); fill the other one
+
+    m_buffer = m_region + header->bufferOffset + (frame & 1) * header->bufferBytes;
+
+    auto *buffer = reinterpret_cast<BufferHeader *>(m_buffer);
+
+    // seqlock: odd sequence before touching the data
+
+    buffer->sequence.store(buffer->sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+    std::atomic_thread_fence(std::memory_order_release);
+
+    m_count = std::uint32_t(std::clamp<std::int64_t>(count, 0, m_capacity));
+
+    buffer->frame = frame;
+
+    buffer->timestampMs = timestampMs;
+
+    buffer->count = m_count;
+}
+
+void TelemetryBusWriter::write(int i, const TelemetrySnapshot &snap)
+{
+
+    if (!m_buffer || i < 0 || std::uint32_t(i) >= m_count)
+        return;
+
+    column<double>(m_layout.latitude)[i] = snap.latitude;
+
+    column<double>(m_layout.longitude)[i] = snap.longitude;
+
+    column<double>(m_layout.altitude)[i] = snap.altitude;
+
+    column<double>(m_layout.heading)[i] = snap.heading;
+
+    column<double>(m_layout.speed)[i] = snap.speed;
+
+    column<std::int64_t>(m_layout.timestampMs)[i] = snap.timestampMs;
+
+    column<std::int32_t>(m_layout.battery)[i] = snap.battery;
+
+    column<std::uint8_t>(m_layout.gpsFix)[i] = std::uint8_t(snap.gpsFix);
+
+    column<std::uint8_t>(m_layout.flags)[i] = Live;
+}
+
+void TelemetryBusWriter::markStale(int i, std::uint8_t flags)
+{
+
+    if (!m_buffer || i < 0 || std::uint32_t(i) >= m_count)
+        return;
+
+    column<std::uint8_t>(m_layout.flags)[i] = std::uint8_t(flags & ~Live);
+}
+
+void TelemetryBusWriter::commitFrame()
+{
+
+    if (!m_buffer)
+        return;
+
+    auto *header = reinterpret_cast<RegionHeader *>(m_region);
+
+    auto *buffer = reinterpret_cast<BufferHeader *>(m_buffer);
+
+    // even sequence: data complete; then point readers at this buffer
+
+    buffer->sequence.store(buffer->sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+
+    m_frame = buffer->frame;
+
+    header->latestFrame.store(m_frame, std::memory_order_release);
+
+    m_buffer = nullptr;
+}
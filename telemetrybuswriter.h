@@ -0,0 +1,81 @@
+/******************************************************************************
+ * TelemetryBusWriter.h
+ * Author: Jatin Kumawat
+ * Date: 19-10-2026
+ *
+ * Description:
+ *   Simulator side of the shared-memory telemetry bus (see TelemetryBus.h).
+ *
+ *   - Creates and owns the POSIX shared-memory object; unlinks it on close
+ *   - Never takes over a region whose writer is still running: a second
+ *  simulator on the same name fails to open unless asked to replace it
+ *   - beginFrame() / write() / commitFrame() fill the back buffer in place
+ *  during the publish loop; a commit is two atomic stores, readers never
+ *  block the tick
+ *   - Drone ids go to a separate table, written once per drone by setId()
+ *   - POSIX only: open() fails on other platforms
+ ******************************************************************************/
+
+#pragma once
+
+#include <QString>
+#include <cstdint>
+#include "TelemetryBus.h"
+#include "TelemetryTypes.h"
+
+class TelemetryBusWriter
+{
+public:
+    TelemetryBusWriter() = default;
+
+    ~TelemetryBusWriter(); // Closes and unlinks the region.
+
+    TelemetryBusWriter(const TelemetryBusWriter &) = delete;
+    TelemetryBusWriter &operator=(const TelemetryBusWriter &) = delete;
+
+    // Creates the shared-memory object name ("/drone-telemetry") sized for capacity drones. An existing
+    // object is replaced only if its writer process has exited, or always with replaceExisting.
+    // On failure returns false and describes the reason in error (if given).
+    bool open(const QString &name, std::uint32_t capacity, QString *error = nullptr, bool replaceExisting = false);
+
+    // Unmaps the region and unlinks it unless another writer has replaced it meanwhile.
+    // Readers that still map it keep the last frame.
+    void close();
+
+    bool isOpen() const { return m_region != nullptr; } // True between a successful open() and close().
+
+    std::uint32_t capacity() const { return m_capacity; } // Maximum drones per frame.
+
+    std::uint64_t framesCommitted() const { return m_frame; } // Frames published so far.
+
+    // Stores the id of row i in the id table. Call before the first frame containing row i.
+    void setId(int i, const QString &id);
+
+    // Starts filling the back buffer. Rows beyond capacity are ignored.
+    void beginFrame(int count, std::int64_t timestampMs);
+
+    // Writes row i of the current frame.
+    void write(int i, const TelemetrySnapshot &snap);
+
+    // Marks row i as not updated this frame (TelemetryBus::Paused / LinkLost).
+    void markStale(int i, std::uint8_t flags);
+
+    // Publishes the frame to readers.
+    void commitFrame();
+
+private:
+    template <typename T>
+    T *column(std::uint64_t offset) const { return reinterpret_cast<T *>(m_buffer + offset); }
+
+    QString m_name;                       // Shared-memory object name.
+    unsigned char *m_region = nullptr;    // Start of the mapping.
+    std::uint64_t m_regionBytes = 0;      // Size of the mapping.
+    std::uint64_t m_device = 0;           // Device and inode of the object, to recognise it on close.
+    std::uint64_t m_inode = 0;
+    std::uint32_t m_capacity = 0;         // Rows per frame.
+    TelemetryBus::Layout m_layout{};      // Column offsets inside a buffer.
+
+    std::uint64_t m_frame = 0;            // Last committed frame number.
+    unsigned char *m_buffer = nullptr;    // Buffer being filled (between begin and commit).
+    std::uint32_t m_count = 0;            // Rows of the frame being filled.
+};
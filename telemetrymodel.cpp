@@ -1,5 +1,11 @@
 #include "TelemetryModel.h"
 
+#include "MemoryAccounting.h"
+
+#include "Tracing.h"
+
+#include <QDateTime>
+
 TelemetryModel::TelemetryModel(QObject *parent) : QObject(parent) {}
 
 TelemetrySnapshot TelemetryModel::snapshot()
@@ -10,19 +16,61 @@ TelemetrySnapshot TelemetryModel::snapshot()
     return m_snapshot;
 }
 
+void TelemetryModel::subscribeMetric(int metric)
+{
+
+    QMutexLocker locker(&m_mutex);
+
+    m_metrics.subscribe(metric);
+}
+
+void TelemetryModel::unsubscribeMetric(int metric)
+{
+
+    QMutexLocker locker(&m_mutex);
+
+    m_metrics.unsubscribe(metric);
+}
+
+double TelemetryModel::metric(const QString &droneId, int metric)
+{
+
+    QMutexLocker locker(&m_mutex);
+
+    return m_metrics.value(droneId, metric);
+}
+
 void TelemetryModel::updateFromSimulator(const TelemetrySnapshot &snap)
 {
 
+    TraceScope trace("updateFromSimulator", "model");
+
+    // how long the snapshot waited in the queued-signal backlog
+
+    if (Tracing::enabled())
+        Tracing::counter("telemetry age ms", double(QDateTime::currentMSecsSinceEpoch() - snap.timestampMs));
+
     {
 
+        const std::uint64_t waitStart = Tracing::enabled() ? Tracing::nowNs() : 0;
+
         QMutexLocker locker(&m_mutex);
 
+        if (waitStart)
+            Tracing::record("lock wait", "model", waitStart, Tracing::nowNs(), nullptr, 0.0);
+
+        MemoryScope scope(MemorySubsystem::Model);
+
         // basic copy
 
         TelemetrySnapshot old = m_snapshot;
 
         m_snapshot = snap;
 
+        // O(1) per subscribed metric; unused metrics cost nothing
+
+        m_metrics.update(snap);
+
         // emit change signals outside lock as much as possible
     }
 
@@ -5,6 +5,7 @@
 #include <QObject>
 #include <QMutex>
 #include "TelemetryTypes.h"
+#include "DerivedMetrics.h"
 
 // Model class that holds the drone's current telemetry state and manages thread-safe access.
 class TelemetryModel : public QObject
@@ -16,6 +17,14 @@ public:
 
     TelemetrySnapshot snapshot(); // Returns a copy of the current telemetry state in a thread-safe manner.
 
+    // Derived metrics (DerivedMetric::Type) are only computed while subscribed; subscriptions are counted.
+    void subscribeMetric(int metric);
+
+    void unsubscribeMetric(int metric);
+
+    // Latest value of a subscribed metric for a drone, or NaN when it is not computed or the drone is unknown.
+    double metric(const QString &droneId, int metric);
+
 public slots:
 
     // Slot: Receives new telemetry data from the simulator and updates the internal state.
@@ -32,7 +41,9 @@ signals:
 private:
     TelemetrySnapshot m_snapshot; // The internal structure holding the most recent telemetry data.
 
-    QMutex m_mutex; // Mutex to ensure thread-safe read/write access to m_snapshot.
+    DerivedMetrics m_metrics; // Per-drone derived values, updated incrementally with every snapshot.
+
+    QMutex m_mutex; // Mutex to ensure thread-safe read/write access to m_snapshot and m_metrics.
 };
 
 #endif // TELEMETRYMODEL_H
\ No newline at end of file
@@ -0,0 +1,178 @@
+/******************************************************************************
+ * TelemetryWire.h
+ * Author: Jatin Kumawat
+ * Date: 19-10-2026
+ *
+ * Description:
+ *   Compact binary wire format of the UDP telemetry stream.
+ *
+ *   - Fixed little-endian layout, MAVLink-style integer scaling (1e-7 deg,
+ *  millimeters, centidegrees), 32 bytes per drone record
+ *   - Many records per datagram; every full datagram is exactly
+ *  MAX_DATAGRAM_BYTES so the sender can hand runs of them to the kernel
+ *  as one UDP GSO buffer
+ *   - Drone ids travel separately in Ids datagrams (index -> id)
+ *   - Header-only, no Qt: ingest services can include it as is
+ ******************************************************************************/
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace TelemetryWire
+{
+    constexpr std::uint16_t MAGIC = 0x5444;  // "DT"
+    constexpr std::uint8_t VERSION = 1;
+
+    constexpr std::size_t HEADER_BYTES = 16;
+    constexpr std::size_t RECORD_BYTES = 32;     // One drone sample.
+    constexpr std::size_t ID_RECORD_BYTES = 20;  // Drone index + 16-byte id.
+    constexpr std::size_t ID_BYTES = 16;         // Id, UTF-8, NUL-padded (truncated if longer).
+
+    constexpr std::size_t RECORDS_PER_DATAGRAM = 45;
+    constexpr std::size_t IDS_PER_DATAGRAM = 72;
+
+    // Both kinds fill a datagram to the same size, below the 1472-byte UDP payload of a 1500-byte MTU.
+    constexpr std::size_t MAX_DATAGRAM_BYTES = HEADER_BYTES + RECORDS_PER_DATAGRAM * RECORD_BYTES;
+    static_assert(HEADER_BYTES + IDS_PER_DATAGRAM * ID_RECORD_BYTES == MAX_DATAGRAM_BYTES, "full datagrams must have one size");
+    static_assert(MAX_DATAGRAM_BYTES <= 1472, "datagrams must fit a 1500-byte MTU");
+
+    enum class Kind : std::uint8_t
+    {
+        Telemetry = 1, // RECORD_BYTES records.
+        Ids = 2        // ID_RECORD_BYTES records.
+    };
+
+    struct Header
+    {
+        Kind kind = Kind::Telemetry;
+        std::uint16_t count = 0;    // Records in the datagram.
+        std::uint32_t sequence = 0; // Datagram counter of the publisher (gaps = loss).
+        std::uint32_t tick = 0;     // Simulator tick the records belong to.
+    };
+
+    struct Record
+    {
+        std::uint32_t drone = 0;       // Drone index in the simulator.
+        std::int64_t timestampMs = 0;  // Sample time, ms since epoch.
+        std::int32_t latitudeE7 = 0;   // Degrees * 1e7.
+        std::int32_t longitudeE7 = 0;  // Degrees * 1e7.
+        std::int32_t altitudeMm = 0;   // Millimeters.
+        std::uint16_t headingCdeg = 0; // Centidegrees 0-35999.
+        std::uint16_t speedCms = 0;    // cm/s (saturates at 655.35 m/s).
+        std::uint8_t battery = 0;      // Percent.
+        std::uint8_t gpsFix = 0;       // TelemetrySnapshot::GpsFix.
+    };
+
+    // --- little-endian helpers ---
+
+    inline void put16(unsigned char *p, std::uint16_t v)
+    {
+        p[0] = std::uint8_t(v);
+        p[1] = std::uint8_t(v >> 8);
+    }
+
+    inline void put32(unsigned char *p, std::uint32_t v)
+    {
+        put16(p, std::uint16_t(v));
+        put16(p + 2, std::uint16_t(v >> 16));
+    }
+
+    inline void put64(unsigned char *p, std::uint64_t v)
+    {
+        put32(p, std::uint32_t(v));
+        put32(p + 4, std::uint32_t(v >> 32));
+    }
+
+    inline std::uint16_t get16(const unsigned char *p) { return std::uint16_t(p[0] | (p[1] << 8)); }
+
+    inline std::uint32_t get32(const unsigned char *p) { return get16(p) | (std::uint32_t(get16(p + 2)) << 16); }
+
+    inline std::uint64_t get64(const unsigned char *p) { return get32(p) | (std::uint64_t(get32(p + 4)) << 32); }
+
+    // Rounds and saturates a scaled value into an integer range.
+    template <typename T>
+    inline T quantize(double value, double scale, double lo, double hi)
+    {
+        const double v = std::nearbyint(value * scale);
+        return T(v < lo ? lo : (v > hi ? hi : v));
+    }
+
+    // --- encoding ---
+
+    inline void writeHeader(unsigned char *p, const Header &h)
+    {
+        put16(p, MAGIC);
+        p[2] = VERSION;
+        p[3] = std::uint8_t(h.kind);
+        put16(p + 4, h.count);
+        put16(p + 6, 0);
+        put32(p + 8, h.sequence);
+        put32(p + 12, h.tick);
+    }
+
+    inline void writeRecord(unsigned char *p, const Record &r)
+    {
+        put32(p, r.drone);
+        put64(p + 4, std::uint64_t(r.timestampMs));
+        put32(p + 12, std::uint32_t(r.latitudeE7));
+        put32(p + 16, std::uint32_t(r.longitudeE7));
+        put32(p + 20, std::uint32_t(r.altitudeMm));
+        put16(p + 24, r.headingCdeg);
+        put16(p + 26, r.speedCms);
+        p[28] = r.battery;
+        p[29] = r.gpsFix;
+        put16(p + 30, 0);
+    }
+
+    inline void writeIdRecord(unsigned char *p, std::uint32_t drone, const char *id, std::size_t length)
+    {
+        put32(p, drone);
+        std::memset(p + 4, 0, ID_BYTES);
+        std::memcpy(p + 4, id, length < ID_BYTES ? length : ID_BYTES);
+    }
+
+    // --- decoding (receivers) ---
+
+    // Validates and parses a datagram header; checks that the records fit in size bytes.
+    inline bool readHeader(const unsigned char *p, std::size_t size, Header &h)
+    {
+        if (size < HEADER_BYTES || get16(p) != MAGIC || p[2] != VERSION)
+            return false;
+        h.kind = Kind(p[3]);
+        h.count = get16(p + 4);
+        h.sequence = get32(p + 8);
+        h.tick = get32(p + 12);
+        const std::size_t recordBytes = h.kind == Kind::Telemetry ? RECORD_BYTES : (h.kind == Kind::Ids ? ID_RECORD_BYTES : 0);
+        return recordBytes != 0 && HEADER_BYTES + h.count * recordBytes <= size;
+    }
+
+    // Record k of a Telemetry datagram.
+    inline Record readRecord(const unsigned char *datagram, int k)
+    {
+        const unsigned char *p = datagram + HEADER_BYTES + k * RECORD_BYTES;
+        Record r;
+        r.drone = get32(p);
+        r.timestampMs = std::int64_t(get64(p + 4));
+        r.latitudeE7 = std::int32_t(get32(p + 12));
+        r.longitudeE7 = std::int32_t(get32(p + 16));
+        r.altitudeMm = std::int32_t(get32(p + 20));
+        r.headingCdeg = get16(p + 24);
+        r.speedCms = get16(p + 26);
+        r.battery = p[28];
+        r.gpsFix = p[29];
+        return r;
+    }
+
+    // Record k of an Ids datagram: returns the drone index and copies its NUL-terminated id.
+    inline std::uint32_t readIdRecord(const unsigned char *datagram, int k, char (&id)[ID_BYTES + 1])
+    {
+        const unsigned char *p = datagram + HEADER_BYTES + k * ID_RECORD_BYTES;
+        std::memcpy(id, p + 4, ID_BYTES);
+        id[ID_BYTES] = '\0';
+        return get32(p);
+    }
+}
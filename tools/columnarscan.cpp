@@ -0,0 +1,119 @@
+/******************************************************************************
+ * columnarscan.cpp
+ * Author: Jatin Kumawat
+ * Date: 19-10-2026
+ *
+ * Description:
+ *   Scans one field of a columnar telemetry recording.
+ *
+ *   - Prints the schema and size of the recording
+ *   - Summarizes one column (count, min, max, mean) over the values in
+ *  [lo, hi], decoding only row groups whose statistics can match
+ *
+ *   Usage: ColumnarScan <file> [column] [lo hi]
+ *          defaults: altitude, no range
+ ******************************************************************************/
+
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "../ColumnarReader.h"
+
+int main(int argc, char *argv[])
+{
+
+    if (argc < 2)
+    {
+
+        std::fprintf(stderr, "usage: %s <file> [column] [lo hi]\n", argv[0]);
+
+        return 2;
+    }
+
+    const std::string column = argc > 2 ? argv[2] : "altitude";
+
+    const double lo = argc > 4 ? std::atof(argv[3]) : -std::numeric_limits<double>::infinity();
+
+    const double hi = argc > 4 ? std::atof(argv[4]) : std::numeric_limits<double>::infinity();
+
+    ColumnarReader reader;
+
+    std::string error;
+
+    if (!reader.open(argv[1], &error))
+    {
+
+        std::fprintf(stderr, "%s\n", error.c_str());
+
+        return 1;
+    }
+
+    std::printf("%llu rows in %d row groups, %zu drones; columns:", (unsigned long long)reader.rowCount(),
+                reader.rowGroupCount(), reader.ids().size());
+
+    for (int c = 0; c < reader.columnCount(); ++c)
+        std::printf(" %s", reader.column(c).name.c_str());
+
+    std::printf("\n");
+
+    const int c = reader.findColumn(column);
+
+    if (c < 0)
+    {
+
+        std::fprintf(stderr, "no column %s\n", column.c_str());
+
+        return 1;
+    }
+
+    std::vector<double> values;
+
+    long long matched = 0;
+
+    int scanned = 0;
+
+    double min = std::numeric_limits<double>::infinity(), max = -min, sum = 0.0;
+
+    for (int g = 0; g < reader.rowGroupCount(); ++g)
+    {
+
+        // predicate pushdown: the chunk statistics rule out most row groups of a narrow range
+
+        if (!reader.mayContain(g, c, lo, hi))
+            continue;
+
+        if (!reader.readColumn(g, c, values, &error))
+        {
+
+            std::fprintf(stderr, "%s\n", error.c_str());
+
+            return 1;
+        }
+
+        ++scanned;
+
+        for (double v : values)
+        {
+
+            if (v < lo || v > hi)
+                continue;
+
+            ++matched;
+
+            min = v < min ? v : min;
+
+            max = v > max ? v : max;
+
+            sum += v;
+        }
+    }
+
+    std::printf("%s in [%g, %g]: %lld values, min %.7g, max %.7g, mean %.7g (decoded %d of %d row groups)\n",
+                column.c_str(), lo, hi, matched, matched ? min : 0.0, matched ? max : 0.0,
+                matched ? sum / double(matched) : 0.0, scanned, reader.rowGroupCount());
+
+    return 0;
+}
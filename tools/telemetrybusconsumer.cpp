@@ -0,0 +1,124 @@
+/******************************************************************************
+ * telemetrybusconsumer.cpp
+ * Author: Jatin Kumawat
+ * Date: 19-10-2026
+ *
+ * Description:
+ *   Minimal external consumer of the shared-memory telemetry bus.
+ *
+ *   - Maps the bus read-only and polls for new frames
+ *   - Reads each frame in place (zero-copy) and prints a one-line summary
+ *   - Reports frames it missed and reads it had to retry
+ *
+ *   Usage: TelemetryBusConsumer [name] [frames]
+ *          defaults: /drone-telemetry, run until interrupted
+ ******************************************************************************/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+#include "../TelemetryBusReader.h"
+
+int main(int argc, char *argv[])
+{
+
+    const std::string name = argc > 1 ? argv[1] : "/drone-telemetry";
+
+    const long frames = argc > 2 ? std::atol(argv[2]) : 0;
+
+    TelemetryBusReader reader;
+
+    std::string error;
+
+    // the simulator may not be running yet: keep trying for a few seconds
+
+    for (int attempt = 0; !reader.open(name, &error); ++attempt)
+    {
+
+        if (attempt == 50)
+        {
+
+            std::fprintf(stderr, "%s\n", error.c_str());
+
+            return 1;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+
+    std::printf("mapped %s, capacity %u drones\n", name.c_str(), reader.capacity());
+
+    std::uint64_t last = 0;
+
+    long seen = 0, missed = 0, retries = 0;
+
+    while (frames <= 0 || seen < frames)
+    {
+
+        if (reader.latestFrame() == last)
+        {
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+            continue;
+        }
+
+        TelemetryBusReader::FrameView view;
+
+        if (!reader.acquire(view))
+        {
+
+            ++retries;
+
+            continue;
+        }
+
+        // summarize straight from the shared columns
+
+        int live = 0;
+
+        double batterySum = 0.0;
+
+        for (std::uint32_t i = 0; i < view.count; ++i)
+        {
+
+            if (view.flags[i] & TelemetryBus::Live)
+            {
+
+                ++live;
+
+                batterySum += view.battery[i];
+            }
+        }
+
+        const double lat0 = view.count ? view.latitude[0] : 0.0;
+
+        const double lon0 = view.count ? view.longitude[0] : 0.0;
+
+        if (!reader.validate(view))
+        {
+
+            ++retries;
+
+            continue;
+        }
+
+        if (last != 0 && view.frame > last + 1)
+            missed += long(view.frame - last - 1);
+
+        last = view.frame;
+
+        ++seen;
+
+        std::printf("frame %llu t=%lld live=%d/%u battery=%.1f%% %s=(%.6f, %.6f) missed=%ld retries=%ld\n",
+                    (unsigned long long)view.frame, (long long)view.timestampMs, live, view.count,
+                    live ? batterySum / live : 0.0, reader.id(0).c_str(), lat0, lon0, missed, retries);
+
+        std::fflush(stdout);
+    }
+
+    return 0;
+}
@@ -0,0 +1,330 @@
+#include "Tracing.h"
+
+#include <QByteArray>
+
+#include <cerrno>
+
+#include <chrono>
+
+#include <cmath>
+
+#include <cstdio>
+
+#include <cstring>
+
+#include <memory>
+
+#include <mutex>
+
+#include <vector>
+
+std::atomic<bool> Tracing::s_enabled{false};
+
+namespace
+{
+
+    struct Event
+    {
+        const char *name;
+        const char *category; // nullptr for a counter sample
+        const char *argName;
+        std::uint64_t startNs;
+        std::uint64_t durationNs;
+        double value; // argument of a scope, or the counter value
+    };
+
+    // Written only by its thread; the exporter reads the first count events.
+    struct ThreadBuffer
+    {
+        std::unique_ptr<Event[]> events{new Event[Tracing::EventsPerThread]};
+        std::atomic<int> count{0};
+        std::atomic<long long> dropped{0};
+        std::atomic<unsigned> generation{0};
+        std::atomic<const char *> name{nullptr};
+        int tid = 0;
+    };
+
+    const std::chrono::steady_clock::time_point g_origin = std::chrono::steady_clock::now();
+
+    std::atomic<unsigned> g_generation{1};
+
+    // buffers outlive their threads, so a trace still shows threads that have finished
+
+    std::mutex g_registryMutex;
+
+    std::vector<std::unique_ptr<ThreadBuffer>> g_registry;
+
+    thread_local ThreadBuffer *t_buffer = nullptr;
+
+    thread_local const char *t_threadName = nullptr;
+
+    // first event of a thread: the only lock and allocation a thread ever pays for
+    ThreadBuffer *attach()
+    {
+
+        auto buffer = std::make_unique<ThreadBuffer>();
+
+        buffer->name.store(t_threadName, std::memory_order_relaxed);
+
+        std::lock_guard<std::mutex> lock(g_registryMutex);
+
+        buffer->tid = int(g_registry.size()) + 1;
+
+        g_registry.push_back(std::move(buffer));
+
+        t_buffer = g_registry.back().get();
+
+        return t_buffer;
+    }
+
+    void append(const Event &e)
+    {
+
+        ThreadBuffer *buffer = t_buffer ? t_buffer : attach();
+
+        // clear() only bumps the generation; each thread empties its own buffer
+
+        const unsigned generation = g_generation.load(std::memory_order_relaxed);
+
+        if (buffer->generation.load(std::memory_order_relaxed) != generation)
+        {
+
+            buffer->count.store(0, std::memory_order_relaxed);
+
+            buffer->dropped.store(0, std::memory_order_relaxed);
+
+            buffer->generation.store(generation, std::memory_order_release);
+        }
+
+        const int index = buffer->count.load(std::memory_order_relaxed);
+
+        if (index >= Tracing::EventsPerThread)
+        {
+
+            buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+
+            return;
+        }
+
+        buffer->events[index] = e;
+
+        // publishes the event to the exporter
+
+        buffer->count.store(index + 1, std::memory_order_release);
+    }
+
+    std::vector<ThreadBuffer *> currentBuffers()
+    {
+
+        std::lock_guard<std::mutex> lock(g_registryMutex);
+
+        std::vector<ThreadBuffer *> buffers;
+
+        const unsigned generation = g_generation.load(std::memory_order_relaxed);
+
+        for (const auto &buffer : g_registry)
+        {
+
+            if (buffer->generation.load(std::memory_order_acquire) == generation)
+                buffers.push_back(buffer.get());
+        }
+
+        return buffers;
+    }
+
+    // names are literals from this code base, but keep the JSON valid whatever they hold
+    void writeString(std::FILE *file, const char *text)
+    {
+
+        std::fputc('"', file);
+
+        for (const char *c = text; *c; ++c)
+        {
+
+            if (*c == '"' || *c == '\\')
+                std::fputc('\\', file);
+
+            if (static_cast<unsigned char>(*c) >= 0x20)
+                std::fputc(*c, file);
+        }
+
+        std::fputc('"', file);
+    }
+
+    // JSON has no NaN or infinity (e.g. a metric that is not computed yet)
+    double jsonNumber(double value)
+    {
+
+        return std::isfinite(value) ? value : 0.0;
+    }
+
+    bool fail(QString *error, const QString &message)
+    {
+
+        if (error)
+            *error = message;
+
+        return false;
+    }
+}
+
+void Tracing::setEnabled(bool on)
+{
+
+    s_enabled.store(on, std::memory_order_relaxed);
+}
+
+void Tracing::setThreadName(const char *name)
+{
+
+    t_threadName = name;
+
+    if (t_buffer)
+        t_buffer->name.store(name, std::memory_order_relaxed);
+}
+
+std::uint64_t Tracing::nowNs()
+{
+
+    return std::uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - g_origin).count());
+}
+
+void Tracing::record(const char *name, const char *category, std::uint64_t startNs, std::uint64_t endNs,
+                     const char *argName, double argValue)
+{
+
+    append({name, category, argName, startNs, endNs > startNs ? endNs - startNs : 0, argValue});
+}
+
+void Tracing::counter(const char *name, double value)
+{
+
+    if (!enabled())
+        return;
+
+    append({name, nullptr, nullptr, nowNs(), 0, value});
+}
+
+void Tracing::clear()
+{
+
+    g_generation.fetch_add(1, std::memory_order_relaxed);
+}
+
+long long Tracing::eventsRecorded()
+{
+
+    long long total = 0;
+
+    for (ThreadBuffer *buffer : currentBuffers())
+        total += buffer->count.load(std::memory_order_acquire);
+
+    return total;
+}
+
+long long Tracing::eventsDropped()
+{
+
+    long long total = 0;
+
+    for (ThreadBuffer *buffer : currentBuffers())
+        total += buffer->dropped.load(std::memory_order_relaxed);
+
+    return total;
+}
+
+bool Tracing::exportChromeTrace(const QString &path, QString *error)
+{
+
+    const QByteArray fileName = path.toUtf8();
+
+    std::FILE *file = std::fopen(fileName.constData(), "wb");
+
+    if (!file)
+        return fail(error, QString("cannot create %1: %2").arg(path).arg(QString(std::strerror(errno))));
+
+    // timestamps in microseconds; one process, one track per thread
+
+    std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", file);
+
+    bool first = true;
+
+    auto separator = [&first, file]
+    {
+        if (!first)
+            std::fputs(",\n", file);
+
+        first = false;
+    };
+
+    long long dropped = 0;
+
+    for (ThreadBuffer *buffer : currentBuffers())
+    {
+
+        const int count = buffer->count.load(std::memory_order_acquire);
+
+        dropped += buffer->dropped.load(std::memory_order_relaxed);
+
+        if (const char *name = buffer->name.load(std::memory_order_relaxed))
+        {
+
+            separator();
+
+            std::fprintf(file, "{\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"name\":\"thread_name\",\"args\":{\"name\":", buffer->tid);
+
+            writeString(file, name);
+
+            std::fputs("}}", file);
+        }
+
+        for (int i = 0; i < count; ++i)
+        {
+
+            const Event &e = buffer->events[i];
+
+            separator();
+
+            std::fputs("{\"name\":", file);
+
+            writeString(file, e.name);
+
+            if (!e.category)
+            {
+
+                std::fprintf(file, ",\"ph\":\"C\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"args\":{\"value\":%.17g}}", buffer->tid,
+                             double(e.startNs) / 1000.0, jsonNumber(e.value));
+
+                continue;
+            }
+
+            std::fputs(",\"cat\":", file);
+
+            writeString(file, e.category);
+
+            std::fprintf(file, ",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f", buffer->tid,
+                         double(e.startNs) / 1000.0, double(e.durationNs) / 1000.0);
+
+            if (e.argName)
+            {
+
+                std::fputs(",\"args\":{", file);
+
+                writeString(file, e.argName);
+
+                std::fprintf(file, ":%.17g}", jsonNumber(e.value));
+            }
+
+            std::fputc('}', file);
+        }
+    }
+
+    std::fprintf(file, "],\"otherData\":{\"droppedEvents\":%lld}}\n", dropped);
+
+    const bool ok = !std::ferror(file);
+
+    if (std::fclose(file) != 0 || !ok)
+        return fail(error, QString("cannot write %1").arg(path));
+
+    return true;
+}
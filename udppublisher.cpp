@@ -0,0 +1,477 @@
+#include "UdpPublisher.h"
+
+#include <cerrno>
+
+#include <chrono>
+
+#include <cstring>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/udp.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <unistd.h>
+#define UDPPUBLISHER_POSIX 1
+#endif
+
+#if defined(__linux__) && !defined(UDP_SEGMENT)
+#define UDP_SEGMENT 103 // older libc headers
+#endif
+
+using namespace TelemetryWire;
+
+// messages per sendmmsg() and datagrams per GSO buffer (40 * 1456 bytes stays under 64 KiB)
+
+static constexpr int MAX_MESSAGES = 64;
+
+static constexpr std::size_t MAX_SEGMENTS = 40;
+
+static bool fail(QString *error, const QString &message)
+{
+
+    if (error)
+        *error = message;
+
+    return false;
+}
+
+UdpPublisher::~UdpPublisher()
+{
+
+    close();
+}
+
+bool UdpPublisher::open(const QString &host, quint16 port, std::size_t ringSlots, QString *error)
+{
+
+    close();
+
+#ifdef UDPPUBLISHER_POSIX
+
+    addrinfo hints;
+
+    std::memset(&hints, 0, sizeof(hints));
+
+    hints.ai_family = AF_UNSPEC;
+
+    hints.ai_socktype = SOCK_DGRAM;
+
+    addrinfo *found = nullptr;
+
+    const QByteArray hostName = host.toUtf8();
+
+    const std::string service = std::to_string(port);
+
+    const int rc = getaddrinfo(hostName.constData(), service.c_str(), &hints, &found);
+
+    if (rc != 0)
+        return fail(error, QString("cannot resolve %1: %2").arg(host).arg(QString(gai_strerror(rc))));
+
+    int fd = -1;
+
+    int lastError = 0;
+
+    for (addrinfo *a = found; a && fd < 0; a = a->ai_next)
+    {
+
+        fd = socket(a->ai_family, a->ai_socktype, a->ai_protocol);
+
+        if (fd >= 0 && ::connect(fd, a->ai_addr, a->ai_addrlen) != 0)
+        {
+
+            lastError = errno;
+
+            ::close(fd);
+
+            fd = -1;
+        }
+    }
+
+    freeaddrinfo(found);
+
+    if (fd < 0)
+        return fail(error, QString("cannot open UDP socket to %1: %2").arg(host).arg(QString(std::strerror(lastError))));
+
+    // a deep send buffer absorbs a whole tick's burst
+
+    int sendBuffer = 4 << 20;
+
+    setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &sendBuffer, sizeof(sendBuffer));
+
+    bool gso = false;
+
+#ifdef UDP_SEGMENT
+
+    // every send larger than one datagram is split by the kernel (or the NIC) into MAX_DATAGRAM_BYTES pieces
+
+    int segment = int(MAX_DATAGRAM_BYTES);
+
+    gso = setsockopt(fd, IPPROTO_UDP, UDP_SEGMENT, &segment, sizeof(segment)) == 0;
+
+#endif
+
+    std::size_t slotCount = 2;
+
+    while (slotCount < ringSlots)
+        slotCount <<= 1;
+
+    m_slots = std::make_unique<unsigned char[]>(slotCount * MAX_DATAGRAM_BYTES);
+
+    m_lengths = std::make_unique<std::uint16_t[]>(slotCount);
+
+    m_mask = slotCount - 1;
+
+    m_head.store(0, std::memory_order_relaxed);
+
+    m_tail.store(0, std::memory_order_relaxed);
+
+    m_open = nullptr;
+
+    m_sequence = 0;
+
+    m_tick = 0;
+
+    m_idsDirty = !m_ids.empty();
+
+    m_socket = fd;
+
+    m_gso.store(gso, std::memory_order_relaxed);
+
+    m_running.store(true, std::memory_order_release);
+
+    m_sender = std::thread(&UdpPublisher::senderLoop, this);
+
+    return true;
+
+#else
+
+    Q_UNUSED(port);
+
+    Q_UNUSED(ringSlots);
+
+    return fail(error, QString("UDP publisher to %1 needs a POSIX system").arg(host));
+
+#endif
+}
+
+void UdpPublisher::close()
+{
+
+    if (m_socket < 0)
+        return;
+
+    // the sender drains what is queued before it exits
+
+    commitSlot();
+
+    m_running.store(false, std::memory_order_release);
+
+    if (m_sender.joinable())
+        m_sender.join();
+
+#ifdef UDPPUBLISHER_POSIX
+
+    ::close(m_socket);
+
+#endif
+
+    m_socket = -1;
+
+    m_slots.reset();
+
+    m_lengths.reset();
+}
+
+void UdpPublisher::setId(int i, const QString &id)
+{
+
+    if (i < 0)
+        return;
+
+    if (i >= int(m_ids.size()))
+        m_ids.resize(i + 1);
+
+    m_ids[i] = id.toStdString();
+
+    m_idsDirty = true;
+}
+
+bool UdpPublisher::openSlot(Kind kind)
+{
+
+    const std::size_t head = m_head.load(std::memory_order_relaxed);
+
+    // ring full: the sender is behind, drop instead of waiting
+
+    if (head - m_tail.load(std::memory_order_acquire) > m_mask)
+        return false;
+
+    m_openIndex = head;
+
+    m_open = slot(head);
+
+    m_header.kind = kind;
+
+    m_header.count = 0;
+
+    return true;
+}
+
+void UdpPublisher::commitSlot()
+{
+
+    if (!m_open)
+        return;
+
+    m_header.sequence = m_sequence++;
+
+    m_header.tick = m_tick;
+
+    writeHeader(m_open, m_header);
+
+    const std::size_t recordBytes = m_header.kind == Kind::Telemetry ? RECORD_BYTES : ID_RECORD_BYTES;
+
+    m_lengths[m_openIndex & m_mask] = std::uint16_t(HEADER_BYTES + m_header.count * recordBytes);
+
+    if (m_header.kind == Kind::Telemetry)
+        m_recordsQueued.fetch_add(m_header.count, std::memory_order_relaxed);
+
+    // publish the slot to the sender (a plain store, no system call)
+
+    m_head.store(m_openIndex + 1, std::memory_order_release);
+
+    m_open = nullptr;
+}
+
+void UdpPublisher::announceIds()
+{
+
+    for (std::size_t i = 0; i < m_ids.size(); ++i)
+    {
+
+        if (m_open && m_header.count == IDS_PER_DATAGRAM)
+            commitSlot();
+
+        if (!m_open && !openSlot(Kind::Ids))
+            return; // retried with the next tick
+
+        writeIdRecord(m_open + HEADER_BYTES + m_header.count * ID_RECORD_BYTES, std::uint32_t(i), m_ids[i].data(), m_ids[i].size());
+
+        ++m_header.count;
+    }
+
+    commitSlot();
+
+    m_lastIdsMs = m_timestampMs;
+
+    m_idsDirty = false;
+}
+
+void UdpPublisher::beginTick(qint64 timestampMs)
+{
+
+    if (m_socket < 0)
+        return;
+
+    m_timestampMs = timestampMs;
+
+    ++m_tick;
+
+    if (!m_ids.empty() && (m_idsDirty || timestampMs - m_lastIdsMs >= m_idIntervalMs))
+        announceIds();
+}
+
+void UdpPublisher::add(int i, const TelemetrySnapshot &snap)
+{
+
+    if (m_socket < 0)
+        return;
+
+    if (m_open && (m_header.kind != Kind::Telemetry || m_header.count == RECORDS_PER_DATAGRAM))
+        commitSlot();
+
+    if (!m_open && !openSlot(Kind::Telemetry))
+    {
+
+        m_recordsDropped.fetch_add(1, std::memory_order_relaxed);
+
+        return;
+    }
+
+    Record r;
+
+    r.drone = std::uint32_t(i);
+
+    r.timestampMs = snap.timestampMs;
+
+    r.latitudeE7 = quantize<std::int32_t>(snap.latitude, 1e7, -900000000.0, 900000000.0);
+
+    r.longitudeE7 = quantize<std::int32_t>(snap.longitude, 1e7, -1800000000.0, 1800000000.0);
+
+    r.altitudeMm = quantize<std::int32_t>(snap.altitude, 1e3, -2147483648.0, 2147483647.0);
+
+    r.headingCdeg = quantize<std::uint16_t>(snap.heading, 100.0, 0.0, 35999.0);
+
+    r.speedCms = quantize<std::uint16_t>(snap.speed, 100.0, 0.0, 65535.0);
+
+    r.battery = std::uint8_t(snap.battery < 0 ? 0 : (snap.battery > 100 ? 100 : snap.battery));
+
+    r.gpsFix = std::uint8_t(snap.gpsFix);
+
+    writeRecord(m_open + HEADER_BYTES + m_header.count * RECORD_BYTES, r);
+
+    ++m_header.count;
+}
+
+void UdpPublisher::endTick()
+{
+
+    commitSlot();
+}
+
+void UdpPublisher::senderLoop()
+{
+
+    for (;;)
+    {
+
+        // read the flag before the head so nothing committed before close() is left behind
+
+        const bool running = m_running.load(std::memory_order_acquire);
+
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+
+        const std::size_t head = m_head.load(std::memory_order_acquire);
+
+        if (tail == head)
+        {
+
+            if (!running)
+                return;
+
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+
+            continue;
+        }
+
+        m_tail.store(tail + sendBatch(tail, head), std::memory_order_release);
+    }
+}
+
+std::size_t UdpPublisher::sendBatch(std::size_t tail, std::size_t head)
+{
+
+#if defined(UDPPUBLISHER_POSIX) && defined(__linux__)
+
+    mmsghdr messages[MAX_MESSAGES];
+
+    iovec vectors[MAX_MESSAGES];
+
+    std::size_t slotsIn[MAX_MESSAGES];
+
+    const bool gso = m_gso.load(std::memory_order_relaxed);
+
+    int n = 0;
+
+    std::size_t at = tail;
+
+    while (at != head && n < MAX_MESSAGES)
+    {
+
+        const std::size_t first = at;
+
+        std::size_t bytes = m_lengths[at & m_mask];
+
+        ++at;
+
+        // GSO: extend over contiguous slots; every segment but the last must be full
+
+        while (gso && at != head && at - first < MAX_SEGMENTS && (at & m_mask) != 0 && m_lengths[(at - 1) & m_mask] == MAX_DATAGRAM_BYTES)
+        {
+
+            bytes += m_lengths[at & m_mask];
+
+            ++at;
+        }
+
+        vectors[n].iov_base = slot(first);
+
+        vectors[n].iov_len = bytes;
+
+        std::memset(&messages[n], 0, sizeof(mmsghdr));
+
+        messages[n].msg_hdr.msg_iov = &vectors[n];
+
+        messages[n].msg_hdr.msg_iovlen = 1;
+
+        slotsIn[n] = at - first;
+
+        ++n;
+    }
+
+    const int sent = sendmmsg(m_socket, messages, unsigned(n), 0);
+
+    m_sendCalls.fetch_add(1, std::memory_order_relaxed);
+
+    if (sent <= 0)
+    {
+
+        if (sent < 0 && errno == EINTR)
+            return 0;
+
+        if (gso && sent < 0 && errno == EIO)
+        {
+
+            // the device cannot segment: fall back to one datagram per message
+
+            m_gso.store(false, std::memory_order_relaxed);
+
+            return 0;
+        }
+
+        // e.g. ECONNREFUSED while nobody listens: drop the first message and move on
+
+        m_sendErrors.fetch_add(slotsIn[0], std::memory_order_relaxed);
+
+        return slotsIn[0];
+    }
+
+    std::size_t consumed = 0;
+
+    for (int k = 0; k < sent; ++k)
+        consumed += slotsIn[k];
+
+    m_datagramsSent.fetch_add(consumed, std::memory_order_relaxed);
+
+    return consumed;
+
+#elif defined(UDPPUBLISHER_POSIX)
+
+    (void)head;
+
+    m_sendCalls.fetch_add(1, std::memory_order_relaxed);
+
+    if (send(m_socket, slot(tail), m_lengths[tail & m_mask], 0) < 0)
+    {
+
+        if (errno == EINTR)
+            return 0;
+
+        m_sendErrors.fetch_add(1, std::memory_order_relaxed);
+    }
+    else
+    {
+
+        m_datagramsSent.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    return 1;
+
+#else
+
+    return head - tail;
+
+#endif
+}
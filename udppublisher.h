@@ -0,0 +1,123 @@
+/******************************************************************************
+ * UdpPublisher.h
+ * Author: Jatin Kumawat
+ * Date: 19-10-2026
+ *
+ * Description:
+ *   Batched UDP output of the fleet telemetry (wire format in TelemetryWire.h).
+ *
+ *   - The tick thread packs records straight into preallocated datagram
+ *  slots of a single-producer/single-consumer ring: no allocation, no
+ *  locks and no system calls on the tick path
+ *   - A dedicated sender thread drains the ring with sendmmsg(), handing
+ *  runs of full datagrams to the kernel as one UDP GSO buffer when the
+ *  kernel supports it (Linux); one send() per datagram elsewhere
+ *   - A full ring drops records (counted) instead of blocking the tick
+ *   - Drone ids are re-announced periodically for receivers that join late
+ *   - POSIX only: open() fails on other platforms
+ ******************************************************************************/
+
+#pragma once
+
+#include <QString>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "TelemetryTypes.h"
+#include "TelemetryWire.h"
+
+class UdpPublisher
+{
+public:
+    UdpPublisher() = default;
+
+    ~UdpPublisher(); // Flushes queued datagrams and stops the sender thread.
+
+    UdpPublisher(const UdpPublisher &) = delete;
+    UdpPublisher &operator=(const UdpPublisher &) = delete;
+
+    // Connects to host:port (numeric IPv4/IPv6 or a name), allocates ringSlots datagram slots
+    // (rounded up to a power of two) and starts the sender thread.
+    // On failure returns false and describes the reason in error (if given).
+    bool open(const QString &host, quint16 port, std::size_t ringSlots = 8192, QString *error = nullptr);
+
+    // Sends what is queued, stops the sender thread and closes the socket.
+    void close();
+
+    bool isOpen() const { return m_socket >= 0; } // True between a successful open() and close().
+
+    bool usesGso() const { return m_gso.load(std::memory_order_relaxed); } // True while UDP segmentation offload is in use.
+
+    // Remembers the id of drone i; ids are announced with the next tick and every idIntervalMs afterwards.
+    void setId(int i, const QString &id);
+
+    void setIdInterval(qint64 ms) { m_idIntervalMs = ms; } // Re-announcement period of the id table.
+
+    // --- tick thread ---
+
+    void beginTick(qint64 timestampMs); // Starts collecting the records of one tick.
+
+    void add(int i, const TelemetrySnapshot &snap); // Packs the record of drone i.
+
+    void endTick(); // Queues the last, partly filled datagram of the tick.
+
+    // --- statistics (any thread) ---
+
+    std::uint64_t recordsQueued() const { return m_recordsQueued.load(std::memory_order_relaxed); }
+
+    std::uint64_t datagramsSent() const { return m_datagramsSent.load(std::memory_order_relaxed); }
+
+    std::uint64_t sendCalls() const { return m_sendCalls.load(std::memory_order_relaxed); } // System calls made by the sender.
+
+    std::uint64_t recordsDropped() const { return m_recordsDropped.load(std::memory_order_relaxed); } // Ring full.
+
+    std::uint64_t sendErrors() const { return m_sendErrors.load(std::memory_order_relaxed); } // Datagrams the kernel refused.
+
+private:
+    void senderLoop(); // Sender thread body.
+
+    std::size_t sendBatch(std::size_t tail, std::size_t head); // Sends slots [tail, head); returns slots consumed.
+
+    unsigned char *slot(std::size_t n) const { return m_slots.get() + (n & m_mask) * TelemetryWire::MAX_DATAGRAM_BYTES; }
+
+    bool openSlot(TelemetryWire::Kind kind); // Claims the next ring slot for the tick thread.
+
+    void commitSlot(); // Finishes the open slot and hands it to the sender.
+
+    void announceIds(); // Packs the whole id table.
+
+    int m_socket = -1; // Connected UDP socket.
+    std::atomic<bool> m_gso{false}; // UDP_SEGMENT enabled on the socket.
+
+    // --- ring: slots are MAX_DATAGRAM_BYTES apart, so consecutive slots are contiguous ---
+    std::unique_ptr<unsigned char[]> m_slots;
+    std::unique_ptr<std::uint16_t[]> m_lengths; // Bytes used in each slot.
+    std::size_t m_mask = 0;
+    alignas(64) std::atomic<std::size_t> m_head{0}; // Next slot the tick thread fills.
+    alignas(64) std::atomic<std::size_t> m_tail{0}; // Next slot the sender sends.
+
+    // --- tick thread state ---
+    alignas(64) unsigned char *m_open = nullptr; // Slot being filled, or null.
+    std::size_t m_openIndex = 0;                 // Ring position of m_open.
+    TelemetryWire::Header m_header;              // Header of the open slot.
+    std::uint32_t m_sequence = 0;                // Next datagram sequence number.
+    std::uint32_t m_tick = 0;                    // Current tick number.
+    qint64 m_timestampMs = 0;                    // Time of the current tick.
+    qint64 m_lastIdsMs = 0;                      // Last id announcement.
+    qint64 m_idIntervalMs = 5000;
+    bool m_idsDirty = false;                     // Ids changed since the last announcement.
+    std::vector<std::string> m_ids;              // UTF-8 ids by drone index.
+
+    // --- sender thread ---
+    std::thread m_sender;
+    std::atomic<bool> m_running{false};
+
+    std::atomic<std::uint64_t> m_recordsQueued{0};
+    std::atomic<std::uint64_t> m_datagramsSent{0};
+    std::atomic<std::uint64_t> m_sendCalls{0};
+    std::atomic<std::uint64_t> m_recordsDropped{0};
+    std::atomic<std::uint64_t> m_sendErrors{0};
+};
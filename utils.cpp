@@ -1,5 +1,7 @@
 #include "utils.h"
 
+#include "FastRandom.h"
+
 double randRange(double low, double high)
 {
 
@@ -12,4 +14,14 @@ double randRange(double low, double high)
     int r = QRandomGenerator::global()->bounded(L, H);
 
     return r / 1000000.0;
-}
\ No newline at end of file
+}
+
+double randGaussian(double sigma)
+{
+
+    // one lock-free generator per thread, seeded once from the global generator
+
+    thread_local FastRandom rng(QRandomGenerator::global()->generate64());
+
+    return sigma * rng.gaussian();
+}
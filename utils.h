@@ -8,6 +8,10 @@
 
 double randRange(double low, double high);
 
+// Function to generate a normally distributed value with the given standard deviation (mean 0).
+
+double randGaussian(double sigma);
+
 
 
 #endif // UTILS_H
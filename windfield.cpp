@@ -0,0 +1,261 @@
+#include "WindField.h"
+
+#include "FastRandom.h"
+
+#include <algorithm>
+
+#include <cmath>
+
+#if defined(__SSE__) || defined(_M_X64) || defined(_M_AMD64)
+#include <xmmintrin.h>
+#define WINDFIELD_SSE 1
+#endif
+
+namespace
+{
+
+    // grid cell and fractional offset of a coordinate, clamped to the grid (NaN to the first node:
+    // int() of NaN is undefined and would index outside the nodes)
+
+    struct Axis
+    {
+
+        int cell;
+
+        float t;
+    };
+
+    inline Axis locate(double scaled, int nodes)
+    {
+
+        const double maxCell = double(nodes - 1);
+
+        scaled = !(scaled >= 0.0) ? 0.0 : std::min(scaled, maxCell);
+
+        int cell = std::min(int(scaled), nodes - 2);
+
+        return {cell, float(scaled - cell)};
+    }
+
+#ifdef WINDFIELD_SSE
+
+    inline __m128 lerp4(__m128 a, __m128 b, __m128 t)
+    {
+
+        return _mm_add_ps(a, _mm_mul_ps(t, _mm_sub_ps(b, a)));
+    }
+
+#endif
+}
+
+WindField::WindField(const WindFieldConfig &config) : m_config(config)
+{
+
+    // at least two nodes per axis so there is always a cell to interpolate in
+
+    m_config.cellsEast = std::max(2, m_config.cellsEast);
+
+    m_config.cellsNorth = std::max(2, m_config.cellsNorth);
+
+    m_config.layers = std::max(2, m_config.layers);
+
+    const WindFieldConfig &c = m_config;
+
+    m_invCell = 1.0 / c.cellMeters;
+
+    m_invLayer = 1.0 / c.layerMeters;
+
+    m_minEast = -0.5 * (c.cellsEast - 1) * c.cellMeters;
+
+    m_minNorth = -0.5 * (c.cellsNorth - 1) * c.cellMeters;
+
+    m_nodes.resize(std::size_t(c.cellsEast) * c.cellsNorth * c.layers);
+
+    // mean wind blows towards baseFromDeg + 180
+
+    const double fromRad = c.baseFromDeg * M_PI / 180.0;
+
+    const double baseEast = -c.baseSpeed * std::sin(fromRad);
+
+    const double baseNorth = -c.baseSpeed * std::cos(fromRad);
+
+    // a few random plane-wave gust modes, wavelengths 1-5 km
+
+    const int MODES = 4;
+
+    double kEast[MODES], kNorth[MODES], phase[MODES], dirEast[MODES], dirNorth[MODES];
+
+    FastRandom rng(c.seed);
+
+    for (int m = 0; m < MODES; ++m)
+    {
+
+        const double wavelength = 1000.0 + 4000.0 * rng.uniform();
+
+        const double angle = 2.0 * M_PI * rng.uniform();
+
+        kEast[m] = 2.0 * M_PI / wavelength * std::cos(angle);
+
+        kNorth[m] = 2.0 * M_PI / wavelength * std::sin(angle);
+
+        phase[m] = 2.0 * M_PI * rng.uniform();
+
+        const double gustDir = 2.0 * M_PI * rng.uniform();
+
+        dirEast[m] = std::cos(gustDir);
+
+        dirNorth[m] = std::sin(gustDir);
+    }
+
+    const double thermalEast = 2.0 * M_PI / 1500.0;
+
+    const double thermalNorth = 2.0 * M_PI / 1800.0;
+
+    for (int y = 0; y < c.cellsNorth; ++y)
+    {
+
+        const double north = m_minNorth + y * c.cellMeters;
+
+        for (int x = 0; x < c.cellsEast; ++x)
+        {
+
+            const double east = m_minEast + x * c.cellMeters;
+
+            double gustEast = 0.0, gustNorth = 0.0;
+
+            for (int m = 0; m < MODES; ++m)
+            {
+
+                const double s = std::sin(kEast[m] * east + kNorth[m] * north + phase[m]);
+
+                gustEast += dirEast[m] * s;
+
+                gustNorth += dirNorth[m] * s;
+            }
+
+            gustEast *= c.gustAmplitude / MODES;
+
+            gustNorth *= c.gustAmplitude / MODES;
+
+            const double thermal = c.updraftAmplitude * std::sin(thermalEast * east) * std::sin(thermalNorth * north);
+
+            for (int z = 0; z < c.layers; ++z)
+            {
+
+                const double height = z * c.layerMeters;
+
+                // power-law shear, no wind at ground level
+
+                const double shear = height > 0.0 ? std::pow(height / c.referenceHeight, c.shearExponent) : 0.0;
+
+                // thermals build up over the first ~50 m
+
+                const double lift = height / (height + 50.0);
+
+                Node &node = m_nodes[index(x, y, z)];
+
+                node.east = float(shear * (baseEast + gustEast));
+
+                node.north = float(shear * (baseNorth + gustNorth));
+
+                node.up = float(lift * thermal);
+
+                node.pad = 0.0f;
+            }
+        }
+    }
+}
+
+void WindField::sample(double east, double north, double up, double &windEast, double &windNorth, double &windUp) const
+{
+
+    sampleBatch(&east, &north, &up, 1, &windEast, &windNorth, &windUp);
+}
+
+void WindField::sampleBatch(const double *east, const double *north, const double *up, int count,
+                            double *windEast, double *windNorth, double *windUp) const
+{
+
+    const int layers = m_config.layers;
+
+    const int rowStride = m_config.cellsEast * layers;
+
+    const Node *nodes = m_nodes.data();
+
+    for (int i = 0; i < count; ++i)
+    {
+
+        const Axis ax = locate((east[i] - m_minEast) * m_invCell, m_config.cellsEast);
+
+        const Axis ay = locate((north[i] - m_minNorth) * m_invCell, m_config.cellsNorth);
+
+        const Axis az = locate(up[i] * m_invLayer, layers);
+
+        // corner naming: c<y><x><z>
+
+        const Node *c000 = nodes + index(ax.cell, ay.cell, az.cell);
+
+        const Node *c010 = c000 + layers;
+
+        const Node *c100 = c000 + rowStride;
+
+        const Node *c110 = c100 + layers;
+
+#ifdef WINDFIELD_SSE
+
+        // each node is one aligned 4-float load; all three wind components blend at once
+
+        const __m128 tz = _mm_set1_ps(az.t);
+
+        const __m128 tx = _mm_set1_ps(ax.t);
+
+        const __m128 ty = _mm_set1_ps(ay.t);
+
+        const __m128 v00 = lerp4(_mm_load_ps(&c000->east), _mm_load_ps(&c000[1].east), tz);
+
+        const __m128 v01 = lerp4(_mm_load_ps(&c010->east), _mm_load_ps(&c010[1].east), tz);
+
+        const __m128 v10 = lerp4(_mm_load_ps(&c100->east), _mm_load_ps(&c100[1].east), tz);
+
+        const __m128 v11 = lerp4(_mm_load_ps(&c110->east), _mm_load_ps(&c110[1].east), tz);
+
+        const __m128 v = lerp4(lerp4(v00, v01, tx), lerp4(v10, v11, tx), ty);
+
+        alignas(16) float out[4];
+
+        _mm_store_ps(out, v);
+
+        windEast[i] = out[0];
+
+        windNorth[i] = out[1];
+
+        windUp[i] = out[2];
+
+#else
+
+        const float tz = az.t, tx = ax.t, ty = ay.t;
+
+        auto blend = [&](float Node::*field)
+        {
+            auto lerp = [](float a, float b, float t) { return a + t * (b - a); };
+
+            const float v00 = lerp(c000->*field, c000[1].*field, tz);
+
+            const float v01 = lerp(c010->*field, c010[1].*field, tz);
+
+            const float v10 = lerp(c100->*field, c100[1].*field, tz);
+
+            const float v11 = lerp(c110->*field, c110[1].*field, tz);
+
+            return lerp(lerp(v00, v01, tx), lerp(v10, v11, tx), ty);
+        };
+
+        windEast[i] = blend(&Node::east);
+
+        windNorth[i] = blend(&Node::north);
+
+        windUp[i] = blend(&Node::up);
+
+#endif
+    }
+}
@@ -0,0 +1,77 @@
+/******************************************************************************
+ * WindField.h
+ * Author: Jatin Kumawat
+ * Date: 19-10-2026
+ *
+ * Description:
+ *   Precomputed, gridded 3D wind field around a geographic origin.
+ *
+ *   - Built once from a WindFieldConfig (base wind with a power-law shear
+ *  profile, smooth horizontal gust modes and thermal updrafts)
+ *   - Nodes are stored as packed float4 (east, north, up, pad) so a grid
+ *  corner is a single 16-byte load; a default grid fits in L2 cache
+ *   - Trilinear interpolation with SSE, sampled in batch for a whole fleet
+ ******************************************************************************/
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+// Parameters of the synthetic wind field. Local coordinates are meters
+// east/north of (originLatitude, originLongitude) and meters above ground.
+struct WindFieldConfig
+{
+    double originLatitude = 0.0;    // Grid center (degrees).
+    double originLongitude = 0.0;   // Grid center (degrees).
+    int cellsEast = 64;             // Grid nodes along east.
+    int cellsNorth = 64;            // Grid nodes along north.
+    int layers = 8;                 // Grid nodes along altitude.
+    double cellMeters = 250.0;      // Horizontal node spacing.
+    double layerMeters = 25.0;      // Vertical node spacing.
+    double baseSpeed = 5.0;         // Wind speed at referenceHeight (m/s).
+    double baseFromDeg = 270.0;     // Meteorological direction the wind blows from.
+    double referenceHeight = 10.0;  // Height of baseSpeed (meters).
+    double shearExponent = 0.14;    // Power-law wind shear exponent.
+    double gustAmplitude = 1.5;     // Horizontal perturbation amplitude (m/s).
+    double updraftAmplitude = 0.8;  // Thermal vertical wind amplitude (m/s).
+    std::uint64_t seed = 1;         // Seed of the perturbation modes.
+};
+
+class WindField
+{
+public:
+    explicit WindField(const WindFieldConfig &config = WindFieldConfig()); // Builds the grid.
+
+    const WindFieldConfig &config() const { return m_config; } // Parameters used to build the grid.
+
+    // Wind (m/s, east/north/up) at a local position; positions outside the grid are clamped,
+    // a NaN coordinate samples the first node on its axis.
+    void sample(double east, double north, double up, double &windEast, double &windNorth, double &windUp) const;
+
+    // Batched sample over count positions (structure-of-arrays in and out).
+    void sampleBatch(const double *east, const double *north, const double *up, int count,
+                     double *windEast, double *windNorth, double *windUp) const;
+
+private:
+    // One grid node, padded to 16 bytes for aligned SIMD loads.
+    struct alignas(16) Node
+    {
+        float east, north, up, pad;
+    };
+
+    // Index of node (x, y, z). Altitude is innermost: the z/z+1 corners share a cache line.
+    int index(int x, int y, int z) const { return (y * m_config.cellsEast + x) * m_config.layers + z; }
+
+    WindFieldConfig m_config; // Build parameters.
+
+    std::vector<Node> m_nodes; // cellsNorth * cellsEast * layers nodes.
+
+    double m_minEast = 0.0; // Local coordinate of node x = 0.
+
+    double m_minNorth = 0.0; // Local coordinate of node y = 0.
+
+    double m_invCell = 0.0; // 1 / cellMeters.
+
+    double m_invLayer = 0.0; // 1 / layerMeters.
+};